@@ -0,0 +1,28 @@
+#ifndef ACKLEY_FUNCTION_H
+#define ACKLEY_FUNCTION_H
+
+#include "ObjectiveFunction.h"
+#include <cmath>
+
+// 原式为 -20 exp(-0.2 √(Σx²/D)) - exp(Σcos(2πx)/D) + 20 + e。
+// 用 cos(2πx) = 1 - 2 sin²(πx) 与 expm1 改写为两个非负项之和，最优解附近不会由接近 20 + e 的数相减，单精度下仍能精确到 0
+class AckleyFunction : public ObjectiveFunction {
+public:
+    AckleyFunction(int dim): dimension(dim) {}
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        Scalar sumSq = 0;
+        Scalar sumSin = 0;
+        for (int i = 0; i < dimension; ++i) {
+            Scalar s = std::sin(static_cast<Scalar>(M_PI) * x[i]);
+            sumSq += x[i] * x[i];
+            sumSin += s * s;
+        }
+        return static_cast<Scalar>(-20 * std::expm1(-0.2 * std::sqrt(static_cast<double>(sumSq) / dimension))
+                                   - M_E * std::expm1(-2.0 * sumSin / dimension));
+    }
+
+private:
+    int dimension;
+};
+
+#endif // ACKLEY_FUNCTION_H
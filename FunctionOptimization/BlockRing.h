@@ -0,0 +1,63 @@
+#ifndef BLOCK_RING_H
+#define BLOCK_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// 单生产者/单消费者的无锁环形缓冲区，每个槽位是固定长度的 double 数组。
+// 内存由调用者提供（堆内存或进程间共享内存均可），缓冲区本身不做任何分配。
+class BlockRing {
+public:
+    static size_t bytesRequired(size_t slots, size_t blockSize) {
+        return sizeof(Header) + slots * blockSize * sizeof(double);
+    }
+
+    // initialize 为 false 时表示附着到另一方已经初始化好的内存上
+    BlockRing(void* memory, size_t slots, size_t blockSize, bool initialize = true)
+        : header(static_cast<Header*>(memory)),
+          data(reinterpret_cast<double*>(static_cast<char*>(memory) + sizeof(Header))),
+          slots(slots), blockSize(blockSize)
+    {
+        if (initialize) {
+            new (header) Header();
+        }
+    }
+
+    size_t getBlockSize() const { return blockSize; }
+
+    // 生产者：取得下一个空闲槽位，缓冲区已满时返回 nullptr（不阻塞）
+    double* acquire() {
+        uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        if (tail - header->head.load(std::memory_order_acquire) >= slots) return nullptr;
+        return data + (tail % slots) * blockSize;
+    }
+    void publish() {
+        header->tail.store(header->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // 消费者：取得最早写入的槽位，缓冲区为空时返回 nullptr
+    const double* peek() const {
+        uint64_t head = header->head.load(std::memory_order_relaxed);
+        if (head == header->tail.load(std::memory_order_acquire)) return nullptr;
+        return data + (head % slots) * blockSize;
+    }
+    void release() {
+        header->head.store(header->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    struct Header {
+        alignas(64) std::atomic<uint64_t> head{0};
+        alignas(64) std::atomic<uint64_t> tail{0};
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "BlockRing requires lock-free 64-bit atomics");
+
+    Header* header;
+    double* data;
+    size_t slots;
+    size_t blockSize;
+};
+
+#endif // BLOCK_RING_H
@@ -0,0 +1,492 @@
+#include "CMAES.h"
+#include "ThreadPool.h"
+#include "Transform.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+// 协方差更新的分块大小：64×64 个 double 为 32 KB，一块 C 在累加所有更新向量期间留在 L1 中
+const int TILE = 64;
+
+// c[j] += a * u[j]
+inline void axpy(double a, const double* __restrict u, double* __restrict c, int n) {
+    for (int j = 0; j < n; ++j) c[j] += a * u[j];
+}
+
+// 两列的 Givens 旋转：(a, b) <- (c a - s b, s a + c b)
+inline void rotate(double* __restrict a, double* __restrict b, double c, double s, int n) {
+    for (int k = 0; k < n; ++k) {
+        double h = b[k];
+        b[k] = s * a[k] + c * h;
+        a[k] = c * a[k] - s * h;
+    }
+}
+
+// 对称矩阵的特征分解：Householder 变换化为三对角矩阵（tred2），再做隐式 QL 迭代（tql2），同 JAMA。
+// V 按列存放，JAMA 中沿列的内层循环（包括 QL 迭代中占大部分时间的 Givens 旋转）因此都是连续访问。
+// 输入时 V 为 n×n 对称矩阵，返回时 V 的第 j 列（即内存中的第 j 段）为特征值 d[j] 的特征向量；e 为长度 n 的工作区
+void tred2(double* V, double* d, double* e, int n) {
+    auto v = [V, n](int i, int j) -> double& { return V[static_cast<size_t>(j) * n + i]; };
+    for (int j = 0; j < n; ++j) d[j] = v(n - 1, j);
+    for (int i = n - 1; i > 0; --i) {
+        double scale = 0.0;
+        double h = 0.0;
+        for (int k = 0; k < i; ++k) scale += std::fabs(d[k]);
+        if (scale == 0.0) {
+            e[i] = d[i - 1];
+            for (int j = 0; j < i; ++j) {
+                d[j] = v(i - 1, j);
+                v(i, j) = 0.0;
+                v(j, i) = 0.0;
+            }
+        } else {
+            for (int k = 0; k < i; ++k) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            double f = d[i - 1];
+            double g = std::sqrt(h);
+            if (f > 0) g = -g;
+            e[i] = scale * g;
+            h -= f * g;
+            d[i - 1] = f - g;
+            for (int j = 0; j < i; ++j) e[j] = 0.0;
+            for (int j = 0; j < i; ++j) {
+                f = d[j];
+                v(j, i) = f;
+                g = e[j] + v(j, j) * f;
+                for (int k = j + 1; k <= i - 1; ++k) {
+                    g += v(k, j) * d[k];
+                    e[k] += v(k, j) * f;
+                }
+                e[j] = g;
+            }
+            f = 0.0;
+            for (int j = 0; j < i; ++j) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            double hh = f / (h + h);
+            for (int j = 0; j < i; ++j) e[j] -= hh * d[j];
+            for (int j = 0; j < i; ++j) {
+                f = d[j];
+                g = e[j];
+                for (int k = j; k <= i - 1; ++k) v(k, j) -= (f * e[k] + g * d[k]);
+                d[j] = v(i - 1, j);
+                v(i, j) = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+    // 累积变换
+    for (int i = 0; i < n - 1; ++i) {
+        v(n - 1, i) = v(i, i);
+        v(i, i) = 1.0;
+        double h = d[i + 1];
+        if (h != 0.0) {
+            for (int k = 0; k <= i; ++k) d[k] = v(k, i + 1) / h;
+            for (int j = 0; j <= i; ++j) {
+                double g = 0.0;
+                for (int k = 0; k <= i; ++k) g += v(k, i + 1) * v(k, j);
+                for (int k = 0; k <= i; ++k) v(k, j) -= g * d[k];
+            }
+        }
+        for (int k = 0; k <= i; ++k) v(k, i + 1) = 0.0;
+    }
+    for (int j = 0; j < n; ++j) {
+        d[j] = v(n - 1, j);
+        v(n - 1, j) = 0.0;
+    }
+    v(n - 1, n - 1) = 1.0;
+    e[0] = 0.0;
+}
+
+void tql2(double* V, double* d, double* e, int n) {
+    auto v = [V, n](int i, int j) -> double& { return V[static_cast<size_t>(j) * n + i]; };
+    for (int i = 1; i < n; ++i) e[i - 1] = e[i];
+    e[n - 1] = 0.0;
+    double f = 0.0;
+    double tst1 = 0.0;
+    const double eps = std::numeric_limits<double>::epsilon();
+    for (int l = 0; l < n; ++l) {
+        tst1 = std::max(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+        int m = l;
+        while (m < n - 1 && std::fabs(e[m]) > eps * tst1) ++m;
+        if (m > l) {
+            do {
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0) r = -r;
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (int i = l + 2; i < n; ++i) d[i] -= h;
+                f += h;
+                p = d[m];
+                double c = 1.0, c2 = 1.0, c3 = 1.0;
+                double el1 = e[l + 1];
+                double s = 0.0, s2 = 0.0;
+                for (int i = m - 1; i >= l; --i) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    rotate(&v(0, i), &v(0, i + 1), c, s, n);
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (std::fabs(e[l]) > eps * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+}
+
+}
+
+CMAES::CMAES(const ObjectiveFunction& objFunc, int dim, long long budget, double xmin, double xmax,
+             int lambda, double sigma, int restarts, bool separable)
+    : objFunc(objFunc), DIM(dim), BUDGET(budget), X_MIN(xmin), X_MAX(xmax),
+      LAMBDA0(lambda > 1 ? lambda : 4 + static_cast<int>(3.0 * std::log(static_cast<double>(dim)))),
+      SIGMA0(sigma * (xmax - xmin)), MAX_RESTARTS(std::max(0, restarts)), separable(separable),
+      lambda(0), mu(0), sigma(SIGMA0), eigenEval(0), restartCount(0), restartGen(0), gen(rd())
+{
+    mean.resize(DIM);
+    ps.resize(DIM);
+    pc.resize(DIM);
+    eigen.resize(DIM);
+    yw.resize(DIM);
+    zw.resize(DIM);
+    if (separable) {
+        C.resize(DIM);
+        work.resize(DIM);
+    } else {
+        size_t size = static_cast<size_t>(DIM) * DIM;
+        C.resize(size);
+        B.resize(size);
+        packedBD.resize(packedSize(DIM, DIM));
+        packedB.resize(packedSize(DIM, DIM));
+        // 特征分解时 B·diag(eigen) 暂存在前 D×D 个元素中，三对角化的次对角线在最后 D 个元素中
+        work.resize(size + DIM);
+    }
+    best.position.resize(DIM);
+    best.fitness = std::numeric_limits<double>::infinity();
+}
+
+void CMAES::startRestart(int newLambda) {
+    lambda = newLambda;
+    mu = lambda / 2;
+    weights.resize(mu);
+    for (int i = 0; i < mu; ++i) {
+        weights[i] = std::log((lambda + 1) / 2.0) - std::log(i + 1.0);
+    }
+    double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double squares = 0.0;
+    for (auto& w : weights) {
+        w /= sum;
+        squares += w * w;
+    }
+    mueff = 1.0 / squares;
+    double n = DIM;
+    cc = (4.0 + mueff / n) / (n + 4.0 + 2.0 * mueff / n);
+    cs = (mueff + 2.0) / (n + mueff + 5.0);
+    c1 = 2.0 / ((n + 1.3) * (n + 1.3) + mueff);
+    cmu = std::min(1.0 - c1, 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((n + 2.0) * (n + 2.0) + mueff));
+    if (separable) {
+        // 对角协方差自由度只有 D 个，学习率可以放大 (D + 2) / 3 倍
+        c1 *= (n + 2.0) / 3.0;
+        cmu = std::min(1.0 - c1, cmu * (n + 2.0) / 3.0);
+    }
+    damps = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff - 1.0) / (n + 1.0)) - 1.0) + cs;
+    chiN = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+    size_t size = static_cast<size_t>(lambda) * DIM;
+    Z.resize(size);
+    Y.resize(size);
+    X.resize(size);
+    fitness.resize(lambda);
+    ranking.resize(lambda);
+    order.resize(lambda);
+    update.resize(static_cast<size_t>(mu + 1) * DIM);
+    coef.resize(mu + 1);
+
+    std::uniform_real_distribution<> dis_x(X_MIN, X_MAX);
+    for (auto& m : mean) m = dis_x(gen);
+    sigma = SIGMA0;
+    std::fill(ps.begin(), ps.end(), 0.0);
+    std::fill(pc.begin(), pc.end(), 0.0);
+    std::fill(eigen.begin(), eigen.end(), 1.0);
+    if (separable) {
+        std::fill(C.begin(), C.end(), 1.0);
+    } else {
+        std::fill(C.begin(), C.end(), 0.0);
+        std::fill(B.begin(), B.end(), 0.0);
+        for (int i = 0; i < DIM; ++i) {
+            C[static_cast<size_t>(i) * DIM + i] = 1.0;
+            B[static_cast<size_t>(i) * DIM + i] = 1.0;
+        }
+        packMatrix(B.data(), DIM, DIM, packedB.data());
+        packMatrix(B.data(), DIM, DIM, packedBD.data());
+    }
+    eigenEval = evaluations;
+    history.clear();
+    restartGen = 0;
+}
+
+void CMAES::updateEigen() {
+    // C 只维护了下三角，先复制出完整的对称矩阵
+    for (int i = 0; i < DIM; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            double c = C[static_cast<size_t>(i) * DIM + j];
+            B[static_cast<size_t>(i) * DIM + j] = c;
+            B[static_cast<size_t>(j) * DIM + i] = c;
+        }
+    }
+    double* offDiagonal = work.data() + static_cast<size_t>(DIM) * DIM;
+    tred2(B.data(), eigen.data(), offDiagonal, DIM);
+    tql2(B.data(), eigen.data(), offDiagonal, DIM);
+    // 分解结果按列存放，转置为行优先的 B
+    for (int i = 0; i < DIM; ++i) {
+        for (int j = 0; j < i; ++j) std::swap(B[static_cast<size_t>(i) * DIM + j], B[static_cast<size_t>(j) * DIM + i]);
+    }
+    // 舍入误差可能使很小的特征值变为负数
+    double largest = *std::max_element(eigen.begin(), eigen.end());
+    for (auto& e : eigen) e = std::sqrt(std::max(e, largest * 1e-20));
+    for (int i = 0; i < DIM; ++i) {
+        for (int j = 0; j < DIM; ++j) {
+            work[static_cast<size_t>(i) * DIM + j] = B[static_cast<size_t>(i) * DIM + j] * eigen[j];
+        }
+    }
+    packMatrix(work.data(), DIM, DIM, packedBD.data());
+    packMatrix(B.data(), DIM, DIM, packedB.data());
+    eigenEval = evaluations;
+}
+
+void CMAES::sample(int begin, int end, std::mt19937& g) {
+    std::normal_distribution<> normal(0.0, 1.0);
+    for (int k = begin; k < end; ++k) {
+        double* z = &Z[static_cast<size_t>(k) * DIM];
+        double* y = &Y[static_cast<size_t>(k) * DIM];
+        Scalar* x = &X[static_cast<size_t>(k) * DIM];
+        for (int i = 0; i < DIM; ++i) z[i] = normal(g);
+        if (separable) {
+            for (int i = 0; i < DIM; ++i) y[i] = eigen[i] * z[i];
+        } else {
+            matVec(packedBD.data(), DIM, DIM, z, y);
+        }
+        double penalty = 0.0;
+        for (int i = 0; i < DIM; ++i) {
+            double xi = mean[i] + sigma * y[i];
+            x[i] = static_cast<Scalar>(std::min(std::max(xi, X_MIN), X_MAX));
+            penalty += (xi - x[i]) * (xi - x[i]);
+        }
+        ranking[k] = penalty;
+    }
+    objFunc.evalBatch(&X[static_cast<size_t>(begin) * DIM], end - begin, DIM, &fitness[begin]);
+    // 函数值为 NaN 的点排在最后
+    for (int k = begin; k < end; ++k) ranking[k] += std::isnan(fitness[k]) ? HUGE_VAL : fitness[k];
+}
+
+void CMAES::updateCovariance(double decay, int rows) {
+    // C = decay * C + Σ coef[r] u_r u_r^T，只更新下三角。
+    // 按 TILE×TILE 的块遍历，一块内依次累加所有更新向量；有线程池且 D 较大时各行块交错分给各线程，使三角形的工作量均衡
+    int tiles = (DIM + TILE - 1) / TILE;
+    int chunks = pool && DIM >= 4 * TILE ? std::min(pool->size(), tiles) : 1;
+    auto tileRow = [this, decay, rows](int t) {
+        int i0 = t * TILE;
+        int i1 = std::min(DIM, i0 + TILE);
+        for (int j0 = 0; j0 <= i0; j0 += TILE) {
+            int j1 = std::min(DIM, j0 + TILE);
+            for (int i = i0; i < i1; ++i) {
+                double* ci = &C[static_cast<size_t>(i) * DIM];
+                int je = std::min(j1, i + 1);
+                for (int j = j0; j < je; ++j) ci[j] *= decay;
+            }
+            for (int r = 0; r < rows; ++r) {
+                const double* u = &update[static_cast<size_t>(r) * DIM];
+                for (int i = i0; i < i1; ++i) {
+                    int je = std::min(j1, i + 1);
+                    if (je > j0) axpy(coef[r] * u[i], u + j0, &C[static_cast<size_t>(i) * DIM + j0], je - j0);
+                }
+            }
+        }
+    };
+    if (chunks > 1) {
+        pool->parallelFor(chunks, chunks, [&tileRow, tiles, chunks](int, int begin, int end) {
+            for (int c = begin; c < end; ++c) {
+                for (int t = c; t < tiles; t += chunks) tileRow(t);
+            }
+        });
+    } else {
+        for (int t = 0; t < tiles; ++t) tileRow(t);
+    }
+}
+
+void CMAES::updateDistribution() {
+    std::fill(yw.begin(), yw.end(), 0.0);
+    std::fill(zw.begin(), zw.end(), 0.0);
+    for (int r = 0; r < mu; ++r) {
+        int k = order[r];
+        axpy(weights[r], &Y[static_cast<size_t>(k) * DIM], yw.data(), DIM);
+        axpy(weights[r], &Z[static_cast<size_t>(k) * DIM], zw.data(), DIM);
+    }
+    for (int i = 0; i < DIM; ++i) mean[i] += sigma * yw[i];
+
+    // C^{-1/2} yw = B D^{-1} B^T B D zw = B zw，不需要求逆
+    const double* invSqrtY = zw.data();
+    if (!separable) {
+        matVec(packedB.data(), DIM, DIM, zw.data(), work.data());
+        invSqrtY = work.data();
+    }
+    double csn = std::sqrt(cs * (2.0 - cs) * mueff);
+    double psNorm = 0.0;
+    for (int i = 0; i < DIM; ++i) {
+        ps[i] = (1.0 - cs) * ps[i] + csn * invSqrtY[i];
+        psNorm += ps[i] * ps[i];
+    }
+    psNorm = std::sqrt(psNorm);
+    bool hsig = psNorm / std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * (restartGen + 1))) / chiN < 1.4 + 2.0 / (DIM + 1.0);
+    double ccn = hsig ? std::sqrt(cc * (2.0 - cc) * mueff) : 0.0;
+    for (int i = 0; i < DIM; ++i) pc[i] = (1.0 - cc) * pc[i] + ccn * yw[i];
+
+    // 秩一更新（pc）与秩 μ 更新（前 μ 个 y）的向量放在一起
+    double decay = 1.0 - c1 - cmu + (hsig ? 0.0 : c1 * cc * (2.0 - cc));
+    std::copy(pc.begin(), pc.end(), update.begin());
+    coef[0] = c1;
+    for (int r = 0; r < mu; ++r) {
+        const double* y = &Y[static_cast<size_t>(order[r]) * DIM];
+        std::copy(y, y + DIM, update.begin() + static_cast<size_t>(r + 1) * DIM);
+        coef[r + 1] = cmu * weights[r];
+    }
+    if (separable) {
+        for (int i = 0; i < DIM; ++i) {
+            double c = decay * C[i];
+            for (int r = 0; r <= mu; ++r) {
+                double u = update[static_cast<size_t>(r) * DIM + i];
+                c += coef[r] * u * u;
+            }
+            C[i] = c;
+            eigen[i] = std::sqrt(c);
+        }
+    } else {
+        updateCovariance(decay, mu + 1);
+    }
+    sigma *= std::exp(std::min(1.0, cs / damps * (psNorm / chiN - 1.0)));
+    history.push_back(fitness[order[0]]);
+}
+
+bool CMAES::converged() const {
+    // IPOP 的重启条件（Hansen 2009）
+    if (!std::isfinite(sigma)) return true;
+    // TolFun：本代的函数值与最近若干代的最好值都几乎相同。单精度时差值不可能小于函数值的舍入误差，阈值随之放宽
+    size_t window = 10 + static_cast<size_t>(std::ceil(30.0 * DIM / lambda));
+    double range = static_cast<double>(fitness[order[lambda - 1]]) - fitness[order[0]];
+    double tolFun = std::max(1e-12, 4.0 * std::numeric_limits<Scalar>::epsilon() * std::fabs(fitness[order[0]]));
+    if (history.size() >= window) {
+        auto recent = std::minmax_element(history.end() - window, history.end());
+        range = std::max(range, *recent.second - *recent.first);
+        if (range < tolFun) return true;
+    }
+    // TolX：各坐标方向上的步长都已远小于初始步长
+    bool small = true;
+    for (int i = 0; i < DIM && small; ++i) {
+        double c = separable ? C[i] : C[static_cast<size_t>(i) * DIM + i];
+        small = sigma * std::max(std::fabs(pc[i]), std::sqrt(c)) < 1e-12 * SIGMA0;
+    }
+    if (small) return true;
+    // 条件数过大
+    auto extremes = std::minmax_element(eigen.begin(), eigen.end());
+    if (*extremes.second > 1e7 * *extremes.first) return true;
+    // NoEffectCoord：沿某个坐标加上 0.2 倍标准差不再改变评估点（按 Scalar 比较，单精度时更早触发）
+    for (int i = 0; i < DIM; ++i) {
+        double c = separable ? C[i] : C[static_cast<size_t>(i) * DIM + i];
+        if (static_cast<Scalar>(mean[i]) == static_cast<Scalar>(mean[i] + 0.2 * sigma * std::sqrt(c))) return true;
+    }
+    return false;
+}
+
+void CMAES::recordGeneration(int generation) {
+    if (!telemetry.isEnabled()) return;
+    telemetry.beginGeneration(generation, evaluations);
+    for (int k = 0; k < lambda; ++k) {
+        telemetry.addRow(k, &X[static_cast<size_t>(k) * DIM], fitness[k]);
+    }
+    telemetry.endGeneration();
+}
+
+void CMAES::run() {
+    long long budget = maxEvaluations > 0 ? std::min(BUDGET, maxEvaluations) : BUDGET;
+    evaluations = 0;
+    restartCount = 0;
+    best.fitness = std::numeric_limits<Scalar>::infinity();
+    startRestart(LAMBDA0);
+    startProgress();
+    // 快照的行数取最后一次重启的种群大小
+    long long rows = std::min<long long>(budget, static_cast<long long>(LAMBDA0) << std::min(MAX_RESTARTS, 20));
+    telemetry.beginRun(DIM, static_cast<int>(rows), static_cast<int>(std::min<long long>(budget / LAMBDA0 + 1, 1 << 20)));
+
+    for (int generation = 0; evaluations < budget; ++generation) {
+        telemetry.startPhases();
+        // 延迟的特征分解：距上一次超过 0.5 λ / ((c1 + cμ) D) 次评估才重新分解，其间 C 的变化很小
+        if (!separable && evaluations - eigenEval > 0.5 * lambda / (c1 + cmu) / DIM) updateEigen();
+        int chunks = pool ? std::max(1, std::min(pool->size(), lambda)) : 1;
+        while (static_cast<int>(chunkGen.size()) < chunks) chunkGen.emplace_back(gen());
+        if (chunks > 1) {
+            pool->parallelFor(lambda, chunks, [this](int chunk, int begin, int end) { sample(begin, end, chunkGen[chunk]); });
+        } else {
+            sample(0, lambda, gen);
+        }
+        evaluations += lambda;
+        // 采样与评估在各分段中交错进行，整体计入评估阶段
+        telemetry.lap(Telemetry::Evaluation);
+
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [this](int a, int b) { return ranking[a] < ranking[b]; });
+        for (int k = 0; k < lambda; ++k) {
+            if (fitnessLess(fitness[k], best.fitness)) {
+                best.fitness = fitness[k];
+                std::copy(&X[static_cast<size_t>(k) * DIM], &X[static_cast<size_t>(k) * DIM] + DIM, best.position.begin());
+            }
+        }
+        updateDistribution();
+        ++restartGen;
+        telemetry.lap(Telemetry::Selection);
+        recordGeneration(generation);
+        if (checkProgress(generation)) break;
+
+        if (converged()) {
+            if (restartCount == MAX_RESTARTS) break;
+            ++restartCount;
+            startRestart(2 * lambda);
+        }
+    }
+    telemetry.endRun();
+}
+
+const Individual& CMAES::getBestIndividual() const {
+    return best;
+}
+
+double CMAES::getDiversity() const {
+    return populationDiversity(X.data(), lambda, DIM);
+}
+
+int CMAES::copyPopulation(Scalar* X, Scalar* fitness, int capacity) const {
+    int n = std::min(lambda, capacity);
+    std::copy(this->X.begin(), this->X.begin() + static_cast<size_t>(n) * DIM, X);
+    std::copy(this->fitness.begin(), this->fitness.begin() + n, fitness);
+    return lambda;
+}
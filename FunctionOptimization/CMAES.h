@@ -0,0 +1,91 @@
+#ifndef CMAES_H
+#define CMAES_H
+
+#include "Optimizer.h"
+#include "ObjectiveFunction.h"
+#include <random>
+#include <vector>
+
+// 协方差矩阵自适应进化策略（CMA-ES），参数取 Hansen 教程（2016）中的默认值，带 IPOP 重启：
+// 收敛或停滞后从随机位置重新开始，种群大小加倍，直到用完评估次数。
+// 每代从 N(m, σ²C) 采样 λ 个点，成批交给 evalBatch 评估（有线程池时按分段并行采样与评估），
+// 取最好的 μ 个更新均值、进化路径、步长与 C。
+// C 只维护下三角，秩一与秩 μ 更新合并为一次按块遍历，每块在 L1 中累加所有更新向量，内层循环连续、可向量化；
+// 特征分解 C = B D² B^T 延迟进行，与 pycma 相同，每隔 0.5 λ / ((c1 + cμ) D) 次评估才做一次，O(D³) 的代价均摊到每个采样点上为 O(D²)。
+// separable 为 true 时是只维护对角协方差的 sep-CMA-ES（Ros & Hansen 2008），每代 O(λD)，适合上千维的问题。
+// 超出区间的采样点截断到边界上评估，排序时再加上到边界距离平方的罚项
+class CMAES : public Optimizer {
+public:
+    // budget 为所有重启合计的评估次数；lambda 为 0 时取默认的 4 + 3 ln D；sigma 为初始步长占区间宽度的比例
+    CMAES(const ObjectiveFunction& objFunc, int dim, long long budget, double xmin, double xmax,
+          int lambda, double sigma, int restarts, bool separable);
+    virtual void run() override;
+    virtual const Individual& getBestIndividual() const override;
+    virtual double getDiversity() const override;
+    virtual int copyPopulation(Scalar* X, Scalar* fitness, int capacity) const override;
+
+    // 上一次运行中的重启次数
+    int getRestartCount() const { return restartCount; }
+
+private:
+    const ObjectiveFunction& objFunc;
+    int DIM;
+    long long BUDGET;
+    double X_MIN;
+    double X_MAX;
+    int LAMBDA0;
+    double SIGMA0;
+    int MAX_RESTARTS;
+    bool separable;
+
+    // 当前这次重启的策略参数
+    int lambda;
+    int mu;
+    std::vector<double> weights;
+    double mueff, cc, cs, c1, cmu, damps, chiN;
+
+    // 分布状态
+    std::vector<double> mean;
+    double sigma;
+    std::vector<double> ps;
+    std::vector<double> pc;
+    std::vector<double> C;          // 完整版为 D×D 行优先矩阵（只用下三角），sep 版为对角线
+    std::vector<double> B;          // 特征向量（按列），D×D 行优先
+    std::vector<double> eigen;      // C 的特征值的平方根，即各主轴方向的标准差
+    std::vector<double> packedBD;   // B·diag(eigen) 与 B，按 packMatrix 的格式存放，用于 matVec
+    std::vector<double> packedB;
+    long long eigenEval;            // 上一次特征分解时的评估次数
+
+    // 一代的采样：z ~ N(0, I)，y = B D z，x = m + σy；X 为截断到区间内的评估点，与适应度一样按 Scalar 存放，
+    // 分布的状态总是 double
+    std::vector<double> Z;
+    std::vector<double> Y;
+    std::vector<Scalar> X;
+    std::vector<Scalar> fitness;
+    std::vector<double> ranking;    // 加上越界罚项后用于排序的值
+    std::vector<int> order;
+    std::vector<double> update;     // 协方差更新向量（排序后的前 μ 个 y 与 pc），按行存放
+    std::vector<double> coef;       // 各更新向量的系数
+    std::vector<double> yw;         // 前 μ 个 y 与 z 的加权平均
+    std::vector<double> zw;
+    std::vector<double> history;    // 本次重启中各代的最好值，用于判断停滞
+    std::vector<double> work;
+    int restartCount;
+    int restartGen;
+
+    Individual best;
+
+    std::random_device rd;
+    std::mt19937 gen;
+    std::vector<std::mt19937> chunkGen;   // 每个分段一个随机数发生器
+
+    void startRestart(int newLambda);
+    void updateEigen();
+    void sample(int begin, int end, std::mt19937& g);
+    void updateDistribution();
+    void updateCovariance(double decay, int rows);
+    bool converged() const;
+    void recordGeneration(int generation);
+};
+
+#endif // CMAES_H
@@ -3,79 +3,166 @@
 #include <cmath>
 
 DE::DE(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double F, double CR, double xmin, double xmax)
-    : objFunc(objFunc), DIM(dim), POP_SIZE(popSize), MAX_GEN(maxGen), F(F), CR(CR), X_MIN(xmin), X_MAX(xmax),
-      gen(rd()), dis(0.0, 1.0)
+    : objFunc(objFunc), separable(dynamic_cast<const SeparableObjective*>(&objFunc)), DIM(dim), POP_SIZE(popSize), MAX_GEN(maxGen), F(F), CR(CR), X_MIN(xmin), X_MAX(xmax),
+      batched(objFunc.prefersBatch()), gen(rd()), dis(0.0, 1.0)
 {
+    // 种群与试验个体在构造时一次分配好
     population.resize(POP_SIZE);
+    for (auto& ind : population) {
+        ind.position.resize(DIM);
+    }
+    trial.position.resize(DIM);
+    changed.resize(DIM);
+    if (batched) {
+        batchX.resize(static_cast<size_t>(POP_SIZE) * DIM);
+        batchFitness.resize(POP_SIZE);
+    }
 }
 
 void DE::initializePopulation() {
     std::uniform_real_distribution<> dis_x(X_MIN, X_MAX);
     for (auto& ind : population) {
-        ind.position.resize(DIM);
         for (auto& xi : ind.position) {
             xi = dis_x(gen);
         }
-        ind.fitness = objFunc.eval(ind.position);
+        if (!batched) ind.fitness = objFunc.eval(ind.position);
+    }
+    if (batched) {
+        for (int i = 0; i < POP_SIZE; ++i) {
+            std::copy(population[i].position.begin(), population[i].position.end(), &batchX[static_cast<size_t>(i) * DIM]);
+        }
+        objFunc.evalBatch(batchX.data(), POP_SIZE, DIM, batchFitness.data());
+        for (int i = 0; i < POP_SIZE; ++i) population[i].fitness = batchFitness[i];
     }
+    evaluations = POP_SIZE;
+    bestFitness = getBestIndividual().fitness;
 }
 
 void DE::evolve() {
+    telemetry.startPhases();
+    if (batched) {
+        evolveBatch();
+        return;
+    }
     for (int i = 0; i < POP_SIZE; ++i) {
-        Individual trial = mutateAndCrossover(i);
-        selectIndividual(i, trial);
+        mutateAndCrossover(i);
+        evaluateTrial(i);
+        selectIndividual(i);
     }
 }
 
-Individual DE::mutateAndCrossover(int targetIdx) {
+// 先由本代种群生成全部试验个体，一次 evalBatch 评估后再逐个选择（同步更新的 DE），
+// 外部进程池可以同时计算整代，而不是每次只有一个工作进程在忙
+void DE::evolveBatch() {
+    for (int i = 0; i < POP_SIZE; ++i) {
+        mutateAndCrossover(i);
+        std::copy(trial.position.begin(), trial.position.end(), &batchX[static_cast<size_t>(i) * DIM]);
+    }
+    objFunc.evalBatch(batchX.data(), POP_SIZE, DIM, batchFitness.data());
+    evaluations += POP_SIZE;
+    telemetry.lap(Telemetry::Evaluation);
+    for (int i = 0; i < POP_SIZE; ++i) {
+        if (fitnessLess(batchFitness[i], population[i].fitness)) {
+            const Scalar* x = &batchX[static_cast<size_t>(i) * DIM];
+            std::copy(x, x + DIM, population[i].position.begin());
+            population[i].fitness = batchFitness[i];
+            if (fitnessLess(batchFitness[i], bestFitness)) bestFitness = batchFitness[i];
+        }
+    }
+    telemetry.lap(Telemetry::Selection);
+}
+
+void DE::mutateAndCrossover(int targetIdx) {
     int a, b, c;
     do { a = gen() % POP_SIZE; } while (a == targetIdx);
     do { b = gen() % POP_SIZE; } while (b == targetIdx || b == a);
     do { c = gen() % POP_SIZE; } while (c == targetIdx || c == a || c == b);
 
-    Individual trial;
-    trial.position.resize(DIM);
+    const Individual& target = population[targetIdx];
+    const Scalar f = static_cast<Scalar>(F), lo = static_cast<Scalar>(X_MIN), hi = static_cast<Scalar>(X_MAX);
     int rand_idx = gen() % DIM;
+    numChanged = 0;
     for (int j = 0; j < DIM; ++j) {
         if (dis(gen) < CR || j == rand_idx) {
-            trial.position[j] = population[a].position[j] + F * (population[b].position[j] - population[c].position[j]);
-            if (trial.position[j] < X_MIN) trial.position[j] = X_MIN;
-            if (trial.position[j] > X_MAX) trial.position[j] = X_MAX;
+            trial.position[j] = population[a].position[j] + f * (population[b].position[j] - population[c].position[j]);
+            if (trial.position[j] < lo) trial.position[j] = lo;
+            if (trial.position[j] > hi) trial.position[j] = hi;
+            changed[numChanged++] = j;
         } else {
-            trial.position[j] = population[targetIdx].position[j];
+            trial.position[j] = target.position[j];
         }
     }
-    trial.fitness = objFunc.eval(trial.position);
-    return trial;
+    telemetry.lap(Telemetry::Variation);
 }
 
-void DE::selectIndividual(int targetIdx, const Individual& trial) {
-    if (trial.fitness < population[targetIdx].fitness) {
-        population[targetIdx] = trial;
+void DE::evaluateTrial(int targetIdx) {
+    const Individual& target = population[targetIdx];
+    // 改变的坐标少于一半时，增量计算比完整评估更便宜
+    if (separable && 2 * numChanged < DIM) {
+        trial.fitness = separable->update(target.fitness, target.position, trial.position, changed.data(), numChanged);
+        // 增量值带有逐代累积的舍入误差，将成为种群最优时再完整计算一次，使报告的最优值精确
+        if (fitnessLess(trial.fitness, bestFitness)) trial.fitness = objFunc.eval(trial.position);
+    } else {
+        trial.fitness = objFunc.eval(trial.position);
     }
+    ++evaluations;
+    telemetry.lap(Telemetry::Evaluation);
 }
 
-void DE::run() {
+void DE::selectIndividual(int targetIdx) {
+    if (fitnessLess(trial.fitness, population[targetIdx].fitness)) {
+        // 交换缓冲区，被替换的个体成为下一次的试验个体
+        population[targetIdx].position.swap(trial.position);
+        population[targetIdx].fitness = trial.fitness;
+        if (fitnessLess(trial.fitness, bestFitness)) bestFitness = trial.fitness;
+    }
+    telemetry.lap(Telemetry::Selection);
+}
+
+void DE::immigrate(const Scalar* position, Scalar fitness) {
+    auto worst = std::max_element(population.begin(), population.end(),
+                                  [](const Individual& a, const Individual& b) {
+                                      return fitnessLess(a.fitness, b.fitness);
+                                  });
+    if (fitnessLess(fitness, worst->fitness)) {
+        std::copy(position, position + DIM, worst->position.begin());
+        worst->fitness = fitness;
+        if (fitnessLess(fitness, bestFitness)) bestFitness = fitness;
+    }
+}
+
+void DE::initialize() {
     initializePopulation();
-    for (int generation = 0; generation < MAX_GEN; ++generation) {
-        evolve();
-#ifdef ENABLE_DATA_COLLECTION
-        // 记录当前代的种群数据
-        for (int i = 0; i < POP_SIZE; ++i) {
-            std::string line = std::to_string(generation) + "," + std::to_string(i);
-            for (const auto& xi : population[i].position) {
-                line += "," + std::to_string(xi);
-            }
-            line += "," + std::to_string(population[i].fitness);
-            dataBuffer.push_back(line);
-        }
-#endif
+    startProgress();
+    telemetry.beginRun(DIM, POP_SIZE, MAX_GEN);
+}
+
+void DE::step(int generation) {
+    evolve();
+    // 记录当前代的种群数据
+    telemetry.recordPopulation(generation, evaluations, population);
+}
+
+void DE::run() {
+    initialize();
+    for (int generation = 0; generation < MAX_GEN && !evaluationBudgetExhausted(); ++generation) {
+        step(generation);
+        if (checkProgress(generation)) break;
     }
+    finish();
+}
+
+double DE::getDiversity() const {
+    return populationDiversity(population, POP_SIZE);
+}
+
+int DE::copyPopulation(Scalar* X, Scalar* fitness, int capacity) const {
+    return copyRows(population, POP_SIZE, X, fitness, capacity);
 }
 
 const Individual& DE::getBestIndividual() const {
     return *std::min_element(population.begin(), population.end(),
                              [](const Individual& a, const Individual& b) {
-                                 return a.fitness < b.fitness;
+                                 return fitnessLess(a.fitness, b.fitness);
                              });
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "Optimizer.h"
 #include "ObjectiveFunction.h"
+#include "SeparableObjective.h"
 #include <random>
 
 class DE : public Optimizer {
@@ -10,9 +11,21 @@ public:
     DE(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double F, double CR, double xmin, double xmax);
     virtual void run() override;
     virtual const Individual& getBestIndividual() const override;
+    virtual double getDiversity() const override;
+    virtual int copyPopulation(Scalar* X, Scalar* fitness, int capacity) const override;
+
+    // run() 即 initialize + MAX_GEN 次 step + finish
+    virtual bool steppable() const override { return true; }
+    virtual void initialize() override;
+    virtual void step(int generation) override;
+    virtual void finish() override { telemetry.endRun(); }
+    // 迁入个体优于最差个体时替换之
+    virtual void immigrate(const Scalar* position, Scalar fitness) override;
+    const std::vector<Individual>& getPopulation() const { return population; }
 
 private:
     const ObjectiveFunction& objFunc;
+    const SeparableObjective* separable;   // 目标函数可分离时非空
     int DIM;
     int POP_SIZE;
     int MAX_GEN;
@@ -22,14 +35,24 @@ private:
     double X_MAX;
 
     std::vector<Individual> population;
+    Individual trial;
+    std::vector<int> changed;              // 试验个体相对目标个体改变的坐标
+    int numChanged;
+    Scalar bestFitness;                    // 种群最优的适应度，总是完整评估得到的精确值
+    // 目标函数偏好批量评估时，一代的试验个体连续存放在 batchX 中一次评估
+    bool batched;
+    std::vector<Scalar> batchX;
+    std::vector<Scalar> batchFitness;
     std::random_device rd;
     std::mt19937 gen;
     std::uniform_real_distribution<> dis;
 
     void initializePopulation();
     void evolve();
-    Individual mutateAndCrossover(int targetIdx);
-    void selectIndividual(int targetIdx, const Individual& trial);
+    void evolveBatch();
+    void mutateAndCrossover(int targetIdx);
+    void evaluateTrial(int targetIdx);
+    void selectIndividual(int targetIdx);
 };
 
 #endif // DE_H
\ No newline at end of file
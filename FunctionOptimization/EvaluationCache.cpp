@@ -0,0 +1,165 @@
+#include "EvaluationCache.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+uint64_t mix(uint64_t z) {
+    // splitmix64 的最后一步，把每个坐标的各位充分打散
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+}
+
+CachedObjective::CachedObjective(std::unique_ptr<ObjectiveFunction> base, int dim, size_t capacity, int shards)
+    : base(std::move(base)), DIM(dim), shardBits(0)
+{
+    while ((1 << shardBits) < shards) ++shardBits;
+    int count = 1 << shardBits;
+    shardCapacity = std::max<size_t>(1, (capacity + count - 1) / count);
+    this->shards.reset(new Shard[count]);
+}
+
+uint64_t CachedObjective::hash(const Scalar* x) const {
+    uint64_t h = 0x9e3779b97f4a7c15ULL;
+    for (int d = 0; d < DIM; ++d) {
+        // 单精度时只有低 32 位
+        uint64_t bits = 0;
+        std::memcpy(&bits, &x[d], sizeof(Scalar));
+        h = mix(h ^ bits) + d;
+    }
+    return h;
+}
+
+void CachedObjective::unlink(Shard& s, int slot) {
+    if (s.prev[slot] >= 0) s.next[s.prev[slot]] = s.next[slot];
+    else s.head = s.next[slot];
+    if (s.next[slot] >= 0) s.prev[s.next[slot]] = s.prev[slot];
+    else s.tail = s.prev[slot];
+}
+
+void CachedObjective::pushFront(Shard& s, int slot) {
+    s.prev[slot] = -1;
+    s.next[slot] = s.head;
+    if (s.head >= 0) s.prev[s.head] = slot;
+    s.head = slot;
+    if (s.tail < 0) s.tail = slot;
+}
+
+bool CachedObjective::lookup(const Scalar* x, uint64_t h, Scalar& value) const {
+    Shard& s = shardOf(h);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.index.find(h);
+    // 哈希值相同时还要比较坐标，保证精确匹配
+    if (it == s.index.end() || std::memcmp(&s.keys[static_cast<size_t>(it->second) * DIM], x, DIM * sizeof(Scalar)) != 0) {
+        ++s.misses;
+        return false;
+    }
+    int slot = it->second;
+    if (slot != s.head) {
+        unlink(s, slot);
+        pushFront(s, slot);
+    }
+    value = s.values[slot];
+    ++s.hits;
+    return true;
+}
+
+void CachedObjective::insert(const Scalar* x, uint64_t h, Scalar value) const {
+    Shard& s = shardOf(h);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    int slot;
+    auto it = s.index.find(h);
+    if (it != s.index.end()) {
+        // 同一个点或哈希冲突的点，直接覆盖
+        slot = it->second;
+        unlink(s, slot);
+    } else if (s.values.size() < shardCapacity) {
+        slot = static_cast<int>(s.values.size());
+        s.keys.resize(s.keys.size() + DIM);
+        s.values.push_back(0);
+        s.hashes.push_back(0);
+        s.prev.push_back(-1);
+        s.next.push_back(-1);
+        s.index.emplace(h, slot);
+    } else {
+        // 淘汰最久未使用的条目并复用它的位置
+        slot = s.tail;
+        unlink(s, slot);
+        s.index.erase(s.hashes[slot]);
+        s.index.emplace(h, slot);
+    }
+    std::copy(x, x + DIM, &s.keys[static_cast<size_t>(slot) * DIM]);
+    s.values[slot] = value;
+    s.hashes[slot] = h;
+    pushFront(s, slot);
+}
+
+Scalar CachedObjective::eval(const std::vector<Scalar>& x) const {
+    uint64_t h = hash(x.data());
+    Scalar value;
+    if (lookup(x.data(), h, value)) return value;
+    value = base->eval(x);
+    insert(x.data(), h, value);
+    return value;
+}
+
+void CachedObjective::evalBatch(const Scalar* X, int n, int dim, Scalar* out) const {
+    // 未命中的点复制到连续的缓冲区，一次交给被包装的目标函数
+    thread_local std::vector<int> missing;
+    thread_local std::vector<uint64_t> hashes;
+    thread_local std::vector<Scalar> points;
+    thread_local std::vector<Scalar> values;
+    missing.clear();
+    hashes.clear();
+    points.clear();
+    for (int i = 0; i < n; ++i) {
+        const Scalar* x = X + static_cast<size_t>(i) * dim;
+        uint64_t h = hash(x);
+        if (!lookup(x, h, out[i])) {
+            missing.push_back(i);
+            hashes.push_back(h);
+            points.insert(points.end(), x, x + dim);
+        }
+    }
+    if (missing.empty()) return;
+    values.resize(missing.size());
+    base->evalBatch(points.data(), static_cast<int>(missing.size()), dim, values.data());
+    for (size_t k = 0; k < missing.size(); ++k) {
+        out[missing[k]] = values[k];
+        insert(&points[k * dim], hashes[k], values[k]);
+    }
+}
+
+long long CachedObjective::getHits() const {
+    long long total = 0;
+    for (int i = 0; i < (1 << shardBits); ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        total += shards[i].hits;
+    }
+    return total;
+}
+
+long long CachedObjective::getMisses() const {
+    long long total = 0;
+    for (int i = 0; i < (1 << shardBits); ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        total += shards[i].misses;
+    }
+    return total;
+}
+
+void CachedObjective::clear() {
+    for (int i = 0; i < (1 << shardBits); ++i) {
+        Shard& s = shards[i];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.index.clear();
+        s.keys.clear();
+        s.values.clear();
+        s.hashes.clear();
+        s.prev.clear();
+        s.next.clear();
+        s.head = s.tail = -1;
+        s.hits = s.misses = 0;
+    }
+}
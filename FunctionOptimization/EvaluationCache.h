@@ -0,0 +1,60 @@
+#ifndef EVALUATION_CACHE_H
+#define EVALUATION_CACHE_H
+
+#include "ObjectiveFunction.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// 带缓存的目标函数：按坐标的二进制表示精确匹配，命中时不再调用被包装的目标函数。
+// 缓存容量有上限，按最近最少使用（LRU）淘汰；按哈希值分成若干分片，每个分片一把锁，多线程同时查询时很少冲突。
+// evalBatch 只把未命中的点作为一批交给被包装的目标函数，外部进程等批量接口仍然有效。
+// 一次命中约 150 ns（D = 20），只适合评估代价高的目标函数；包装后不再是 SeparableObjective，增量评估随之关闭
+class CachedObjective : public ObjectiveFunction {
+public:
+    // capacity 为所有分片合计的缓存点数，shards 取不小于它的 2 的幂
+    CachedObjective(std::unique_ptr<ObjectiveFunction> base, int dim, size_t capacity, int shards = 16);
+
+    virtual Scalar eval(const std::vector<Scalar>& x) const override;
+    virtual void evalBatch(const Scalar* X, int n, int dim, Scalar* out) const override;
+    virtual bool forkSafe(bool multithreaded) const override { return !multithreaded && base->forkSafe(false); }
+    virtual bool prefersBatch() const override { return base->prefersBatch(); }
+
+    // 命中次数与未命中次数；未命中次数即被包装的目标函数实际的评估次数
+    long long getHits() const;
+    long long getMisses() const;
+    void clear();
+
+private:
+    // 每个分片的条目存放在连续数组中，prev/next 构成按使用时间排序的双向链表，head 为最近使用的条目
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, int> index;
+        std::vector<Scalar> keys;
+        std::vector<Scalar> values;
+        std::vector<uint64_t> hashes;
+        std::vector<int> prev;
+        std::vector<int> next;
+        int head = -1;
+        int tail = -1;
+        long long hits = 0;
+        long long misses = 0;
+    };
+
+    std::unique_ptr<ObjectiveFunction> base;
+    int DIM;
+    size_t shardCapacity;
+    int shardBits;
+    std::unique_ptr<Shard[]> shards;
+
+    uint64_t hash(const Scalar* x) const;
+    Shard& shardOf(uint64_t h) const { return shards[shardBits ? h >> (64 - shardBits) : 0]; }
+    bool lookup(const Scalar* x, uint64_t h, Scalar& value) const;
+    void insert(const Scalar* x, uint64_t h, Scalar value) const;
+    static void unlink(Shard& s, int slot);
+    static void pushFront(Shard& s, int slot);
+};
+
+#endif // EVALUATION_CACHE_H
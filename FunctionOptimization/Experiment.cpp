@@ -0,0 +1,335 @@
+#include "Experiment.h"
+#include "Factory.h"
+#include "EvaluationCache.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+std::vector<std::string> splitList(const std::string& value) {
+    std::vector<std::string> items;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+double toNumber(const std::string& s, const std::string& where) {
+    size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(s, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used != s.size()) throw std::runtime_error(where + ": '" + s + "' is not a number");
+    return value;
+}
+
+bool toBool(const std::string& s, const std::string& where) {
+    if (s == "on" || s == "true" || s == "1") return true;
+    if (s == "off" || s == "false" || s == "0") return false;
+    throw std::runtime_error(where + ": '" + s + "' is not on/off");
+}
+
+// 参数所在的 "文件:行号: "，算法自己的设置优先于共用参数；参数未在文件中给出时为空
+std::string parameterLine(const ExperimentSpec& spec, const std::string& algorithm, const std::string& name) {
+    for (const std::string& section : { algorithm, std::string() }) {
+        auto lines = spec.parameterLines.find(section);
+        if (lines == spec.parameterLines.end()) continue;
+        auto it = lines->second.find(name);
+        if (it != lines->second.end()) return it->second + ": ";
+    }
+    return "";
+}
+
+// 一个具体配置：目标函数、维度、算法与一组参数取值
+struct Config {
+    std::string function;
+    int dim;
+    std::string algorithm;
+    ParameterSet params;
+    double xmin, xmax;
+    std::string directory;
+    std::string label;
+    const ObjectiveFunction* objFunc;
+    std::vector<double> bestFitness;
+    std::vector<double> times;
+    std::vector<long long> evaluations;
+};
+
+// 参数网格的笛卡尔积
+std::vector<ParameterSet> expandGrid(const std::map<std::string, std::vector<double>>& grid) {
+    std::vector<ParameterSet> sets(1);
+    for (const auto& kv : grid) {
+        std::vector<ParameterSet> next;
+        for (const auto& set : sets) {
+            for (double v : kv.second) {
+                ParameterSet s = set;
+                s[kv.first] = v;
+                next.push_back(s);
+            }
+        }
+        sets.swap(next);
+    }
+    return sets;
+}
+
+std::string formatValue(double v) {
+    std::ostringstream os;
+    os << v;
+    return os.str();
+}
+
+void writeResults(const Config& config, int runs) {
+    std::string prefix = config.directory + "/" + config.label;
+    std::ofstream result_file(prefix + "_results.csv");
+    result_file << "Run,BestFitness,Time(s),Evaluations\n";
+    for (int run = 0; run < runs; ++run) {
+        result_file << run + 1 << "," << config.bestFitness[run] << "," << config.times[run] << "," << config.evaluations[run] << "\n";
+    }
+    result_file.close();
+
+    const std::vector<double>& f = config.bestFitness;
+    const std::vector<double>& t = config.times;
+    // 计算统计指标
+    double avg_fitness = std::accumulate(f.begin(), f.end(), 0.0) / runs;
+    double best_overall = *std::min_element(f.begin(), f.end());
+    double worst_overall = *std::max_element(f.begin(), f.end());
+    double sq_sum = std::inner_product(f.begin(), f.end(), f.begin(), 0.0);
+    double stdev = std::sqrt(std::max(0.0, sq_sum / runs - avg_fitness * avg_fitness));
+
+    double avg_time = std::accumulate(t.begin(), t.end(), 0.0) / runs;
+    double sq_sum_time = std::inner_product(t.begin(), t.end(), t.begin(), 0.0);
+    double stdev_time = std::sqrt(std::max(0.0, sq_sum_time / runs - avg_time * avg_time));
+
+    std::ofstream stats_file(prefix + "_statistics.txt");
+    stats_file << algorithmTitle(config.algorithm) << " Optimization Statistics\n";
+    stats_file << "Number of Runs: " << runs << "\n";
+    stats_file << "Best Fitness: " << best_overall << "\n";
+    stats_file << "Worst Fitness: " << worst_overall << "\n";
+    stats_file << "Average Fitness: " << avg_fitness << "\n";
+    stats_file << "Standard Deviation: " << stdev << "\n";
+    stats_file << "Average Time(s): " << avg_time << "\n";
+    stats_file << "Time Standard Deviation(s): " << stdev_time << "\n";
+    stats_file.close();
+}
+
+void runJob(const ExperimentSpec& spec, Config& config, int run, ThreadPool& pool) {
+    std::unique_ptr<Optimizer> optimizer = createOptimizer(config.algorithm, *config.objFunc, config.dim,
+                                                           config.xmin, config.xmax, config.params);
+    // 运行内部的并行（如同步 PSO）与各次运行共用同一个线程池
+    optimizer->setThreadPool(&pool);
+    std::string data_prefix = config.directory + "/" + config.label + "_data/";
+    Telemetry& telemetry = optimizer->getTelemetry();
+    telemetry.setEnabled(spec.telemetry);
+    // 种群快照由后台线程写入二进制轨迹文件，读取方式见 trace_reader.py
+    TraceWriter trace_writer(data_prefix + "population_run_" + std::to_string(run + 1) + ".trace");
+    telemetry.setSnapshots(&trace_writer, spec.snapshotInterval);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    optimizer->run();
+    auto end_time = std::chrono::high_resolution_clock::now();
+
+    config.times[run] = std::chrono::duration_cast<std::chrono::duration<double>>(end_time - start_time).count();
+    config.bestFitness[run] = optimizer->getBestIndividual().fitness;
+    config.evaluations[run] = optimizer->getEvaluationCount();
+
+    if (spec.telemetry) {
+        // 遥测数据在计时结束后写出，不计入优化时间
+        telemetry.writeCsv(data_prefix + "telemetry_run_" + std::to_string(run + 1) + ".csv");
+    }
+    if (trace_writer.getDroppedBlocks() > 0) {
+        std::cerr << config.directory << "/" << config.label << " run " << run + 1 << ": "
+                  << trace_writer.getDroppedBlocks() << " generations dropped from trace (writer fell behind)\n";
+    }
+}
+
+}
+
+ExperimentSpec loadExperimentSpec(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open experiment spec '" + path + "'");
+
+    ExperimentSpec spec;
+    std::string section;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        std::string where = path + ":" + std::to_string(lineNo);
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        if (line.front() == '[') {
+            if (line.back() != ']') throw std::runtime_error(where + ": malformed section header");
+            section = trim(line.substr(1, line.size() - 2));
+            spec.algorithmParameters[section];
+            continue;
+        }
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) throw std::runtime_error(where + ": expected 'key = value'");
+        std::string key = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+        std::vector<std::string> items = splitList(value);
+        if (items.empty()) throw std::runtime_error(where + ": no value for '" + key + "'");
+
+        if (section.empty() && key == "functions") {
+            spec.functions = items;
+        } else if (section.empty() && key == "algorithms") {
+            spec.algorithms = items;
+        } else if (section.empty() && key == "dimensions") {
+            spec.dimensions.clear();
+            for (const auto& item : items) {
+                double dim = toNumber(item, where);
+                if (!(dim >= 1 && dim <= INT_MAX)) throw std::runtime_error(where + ": dimensions must be positive");
+                spec.dimensions.push_back(static_cast<int>(dim));
+            }
+        } else if (section.empty() && key == "runs") {
+            spec.runs = static_cast<int>(toNumber(value, where));
+        } else if (section.empty() && key == "threads") {
+            spec.threads = static_cast<int>(toNumber(value, where));
+        } else if (section.empty() && key == "output") {
+            spec.output = value;
+        } else if (section.empty() && key == "telemetry") {
+            spec.telemetry = toBool(value, where);
+        } else if (section.empty() && key == "worker") {
+            spec.worker = value;
+        } else if (section.empty() && key == "workers") {
+            spec.workers = static_cast<int>(toNumber(value, where));
+        } else if (section.empty() && key == "cache") {
+            spec.cache = static_cast<long long>(toNumber(value, where));
+        } else if (section.empty() && key == "snapshot") {
+            spec.snapshotInterval = static_cast<int>(toNumber(value, where));
+        } else {
+            std::vector<double> values;
+            for (const auto& item : items) values.push_back(toNumber(item, where));
+            if (section.empty()) spec.globalParameters[key] = values;
+            else spec.algorithmParameters[section][key] = values;
+            spec.parameterLines[section][key] = where;
+        }
+    }
+    if (spec.runs <= 0) throw std::runtime_error(path + ": runs must be positive");
+    if (spec.snapshotInterval > 0) spec.telemetry = true;
+    return spec;
+}
+
+void runExperiment(const ExperimentSpec& spec) {
+    bool multipleFunctions = spec.functions.size() > 1;
+    bool multipleDimensions = spec.dimensions.size() > 1;
+
+    // 目标函数只读，同一 (函数, 维度) 的所有任务共享一个实例
+    std::vector<std::unique_ptr<ObjectiveFunction>> objectives;
+    std::vector<std::pair<std::string, const CachedObjective*>> caches;
+    std::vector<Config> configs;
+    for (const auto& function : spec.functions) {
+        for (int dim : spec.dimensions) {
+            bool external = function == "external";
+            double xmin = 0.0, xmax = 0.0;
+            if (external) {
+                if (spec.worker.empty()) throw std::runtime_error("function 'external' needs 'worker = <command>'");
+                objectives.push_back(createExternalObjective(spec.worker, dim, spec.workers));
+            } else {
+                objectives.push_back(createObjective(function, dim));
+                defaultBounds(function, xmin, xmax);
+            }
+            if (spec.cache > 0) {
+                std::unique_ptr<ObjectiveFunction> base = std::move(objectives.back());
+                objectives.back().reset(new CachedObjective(std::move(base), dim, static_cast<size_t>(spec.cache)));
+                caches.push_back({function + " " + std::to_string(dim) + "D", static_cast<CachedObjective*>(objectives.back().get())});
+            }
+
+            for (const auto& algorithm : spec.algorithms) {
+                std::map<std::string, std::vector<double>> grid = spec.globalParameters;
+                auto section = spec.algorithmParameters.find(algorithm);
+                if (section != spec.algorithmParameters.end()) {
+                    for (const auto& kv : section->second) grid[kv.first] = kv.second;
+                }
+                for (const auto& params : expandGrid(grid)) {
+                    Config config;
+                    config.function = function;
+                    config.dim = dim;
+                    config.algorithm = algorithm;
+                    config.params = params;
+                    config.xmin = xmin;
+                    config.xmax = xmax;
+                    auto it = config.params.find("x_min");
+                    if (it != config.params.end()) { config.xmin = it->second; config.params.erase(it); }
+                    it = config.params.find("x_max");
+                    if (it != config.params.end()) { config.xmax = it->second; config.params.erase(it); }
+                    if (external && !(config.xmin < config.xmax)) {
+                        throw std::runtime_error("function 'external' needs x_min < x_max");
+                    }
+
+                    config.directory = spec.output + (multipleFunctions ? "/" + function : "")
+                                       + (multipleDimensions ? "/" + std::to_string(dim) + "D" : "");
+                    // 参数网格中有多个取值的参数体现在文件名上
+                    config.label = algorithm;
+                    for (const auto& kv : grid) {
+                        if (kv.second.size() > 1) config.label += "_" + kv.first + "-" + formatValue(config.params[kv.first]);
+                    }
+                    config.objFunc = objectives.back().get();
+                    config.bestFitness.assign(spec.runs, 0.0);
+                    config.times.assign(spec.runs, 0.0);
+                    config.evaluations.assign(spec.runs, 0);
+                    // 先创建一次，尽早报告错误的参数，并指出它在配置文件中的位置
+                    try {
+                        createOptimizer(algorithm, *config.objFunc, dim, config.xmin, config.xmax, config.params);
+                    } catch (const ParameterError& e) {
+                        throw std::runtime_error(parameterLine(spec, algorithm, e.parameter()) + e.what());
+                    }
+                    configs.push_back(config);
+                }
+            }
+        }
+    }
+
+    for (const auto& config : configs) {
+        fs::create_directories(config.directory);
+        if (spec.telemetry) fs::create_directories(config.directory + "/" + config.label + "_data");
+    }
+
+    ThreadPool pool(spec.threads);
+    std::cout << configs.size() << " configurations x " << spec.runs << " runs on "
+              << pool.size() << " threads" << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    for (auto& config : configs) {
+        for (int run = 0; run < spec.runs; ++run) {
+            Config* c = &config;
+            pool.submit([&spec, c, run, &pool] { runJob(spec, *c, run, pool); });
+        }
+    }
+    pool.wait();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& config : configs) {
+        writeResults(config, spec.runs);
+    }
+    for (const auto& c : caches) {
+        long long hits = c.second->getHits();
+        long long total = hits + c.second->getMisses();
+        std::cout << "Cache " << c.first << ": " << hits << " of " << total << " evaluations served from the cache" << std::endl;
+    }
+    std::cout << "Finished in " << elapsed << " s" << std::endl;
+}
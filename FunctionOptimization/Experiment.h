@@ -0,0 +1,42 @@
+#ifndef EXPERIMENT_H
+#define EXPERIMENT_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+// 实验配置：目标函数 × 维度 × 算法 × 参数网格，每个组合运行 runs 次。
+// 默认值与原先 main.cpp 中写死的参数一致。
+struct ExperimentSpec {
+    std::vector<std::string> functions = { "rastrigin" };
+    std::vector<int> dimensions = { 10 };
+    std::vector<std::string> algorithms = { "SA", "GA", "PSO", "DE" };
+    int runs = 20;
+    int threads = 0;               // 0 表示使用全部硬件线程
+    std::string output = ".";
+    bool telemetry = false;
+    int snapshotInterval = 0;
+    // functions 中的 external 表示由外部进程计算的目标函数：worker 为启动工作进程的命令，
+    // workers 为每个 (external, 维度) 启动的进程数，0 表示使用全部硬件线程。搜索区间须由 x_min / x_max 给出
+    std::string worker;
+    int workers = 0;
+    // 大于 0 时每个 (目标函数, 维度) 带一个容量为 cache 个点的评估缓存，同一组合的所有运行共用
+    long long cache = 0;
+
+    // 所有算法共用的参数（如 pop_size、max_gen、x_min、x_max）
+    std::map<std::string, std::vector<double>> globalParameters;
+    // 各算法自己的参数，会覆盖同名的共用参数；一个参数给出多个取值即构成网格
+    std::map<std::string, std::map<std::string, std::vector<double>>> algorithmParameters;
+    // 各参数所在的 "文件:行号"，按 [算法][参数名] 索引，共用参数的算法名为空，用于报告取值错误
+    std::map<std::string, std::map<std::string, std::string>> parameterLines;
+};
+
+// 读取配置文件，格式见 experiments/sweep.cfg，出错时抛出 std::runtime_error
+ExperimentSpec loadExperimentSpec(const std::string& path);
+
+// 把所有 (配置, 运行次数) 任务分发到线程池上执行，
+// 结果按 <output>/[<function>/][<D>D/]<算法>_results.csv 与 _statistics.txt 写出，
+// 只有一个目标函数或一个维度时省略对应的子目录
+void runExperiment(const ExperimentSpec& spec);
+
+#endif // EXPERIMENT_H
@@ -0,0 +1,261 @@
+#include "ExternalObjective.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <pthread.h>
+#include <spawn.h>
+#include <stdexcept>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace {
+
+// 在作用域内屏蔽本线程的 SIGPIPE：写入已关闭的管道时 writev 返回 EPIPE，
+// 产生的 SIGPIPE 在恢复屏蔽字之前被取走，不会送达进程
+class SigpipeBlock {
+public:
+    SigpipeBlock() {
+        sigemptyset(&set);
+        sigaddset(&set, SIGPIPE);
+        sigset_t pending;
+        sigpending(&pending);
+        wasPending = sigismember(&pending, SIGPIPE) == 1;
+        pthread_sigmask(SIG_BLOCK, &set, &old);
+    }
+    ~SigpipeBlock() {
+        if (!wasPending) {
+            struct timespec zero = {0, 0};
+            while (sigtimedwait(&set, nullptr, &zero) < 0 && errno == EINTR) {}
+        }
+        pthread_sigmask(SIG_SETMASK, &old, nullptr);
+    }
+    SigpipeBlock(const SigpipeBlock&) = delete;
+    SigpipeBlock& operator=(const SigpipeBlock&) = delete;
+
+private:
+    sigset_t set;
+    sigset_t old;
+    bool wasPending;
+};
+
+// 写满 iov 描述的全部数据，管道可能只接受一部分
+void writeAll(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("external objective: worker closed its input");
+        }
+        while (count > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+            written -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+            iov->iov_len -= written;
+        }
+    }
+}
+
+// 每段是否成功的标志，线程局部，避免每次调用分配
+std::vector<char>& okFlags(int count) {
+    thread_local std::vector<char> flags;
+    flags.assign(count, 0);
+    return flags;
+}
+
+void readAll(int fd, void* data, size_t bytes) {
+    char* p = static_cast<char*>(data);
+    while (bytes > 0) {
+        ssize_t got = read(fd, p, bytes);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) throw std::runtime_error("external objective: worker exited or sent an incomplete reply");
+        p += got;
+        bytes -= got;
+    }
+}
+
+}
+
+ExternalObjective::ExternalObjective(const std::string& command, int dim, int workers)
+    : command(command), dimension(dim)
+{
+    if (workers <= 0) workers = std::max(1u, std::thread::hardware_concurrency());
+    start(workers);
+}
+
+ExternalObjective::~ExternalObjective() {
+    stop();
+}
+
+void ExternalObjective::start(int count) {
+    for (int w = 0; w < count; ++w) {
+        // 管道两端都带 O_CLOEXEC，后启动的工作进程不会继承前面进程的管道，关闭写端即可让对应进程读到 EOF
+        int toWorker[2], fromWorker[2];
+        if (pipe2(toWorker, O_CLOEXEC) != 0) {
+            stop();
+            throw std::runtime_error("external objective: cannot create pipe");
+        }
+        if (pipe2(fromWorker, O_CLOEXEC) != 0) {
+            close(toWorker[0]);
+            close(toWorker[1]);
+            stop();
+            throw std::runtime_error("external objective: cannot create pipe");
+        }
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, toWorker[0], STDIN_FILENO);
+        posix_spawn_file_actions_adddup2(&actions, fromWorker[1], STDOUT_FILENO);
+        std::string shellCommand = "exec " + command;
+        char* argv[] = { const_cast<char*>("sh"), const_cast<char*>("-c"), const_cast<char*>(shellCommand.c_str()), nullptr };
+        pid_t pid;
+        int error = posix_spawn(&pid, "/bin/sh", &actions, nullptr, argv, environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(toWorker[0]);
+        close(fromWorker[1]);
+        if (error != 0) {
+            close(toWorker[1]);
+            close(fromWorker[0]);
+            stop();
+            throw std::runtime_error("external objective: cannot start '" + command + "'");
+        }
+        workers.push_back({pid, toWorker[1], fromWorker[0]});
+        idle.push_back(w);
+        ++alive;
+    }
+}
+
+void ExternalObjective::stop() {
+    for (const auto& w : workers) {
+        if (w.pid >= 0) close(w.input);
+    }
+    for (const auto& w : workers) {
+        if (w.pid < 0) continue;
+        close(w.output);
+        int status;
+        while (waitpid(w.pid, &status, 0) < 0 && errno == EINTR) {}
+    }
+    workers.clear();
+    idle.clear();
+    alive = 0;
+}
+
+void ExternalObjective::acquire(int wanted, std::vector<int>& out) const {
+    std::unique_lock<std::mutex> lock(mutex);
+    available.wait(lock, [this] { return !idle.empty() || alive == 0; });
+    if (idle.empty()) throw std::runtime_error("external objective: all workers have failed");
+    out.clear();
+    while (!idle.empty() && static_cast<int>(out.size()) < wanted) {
+        out.push_back(idle.back());
+        idle.pop_back();
+    }
+}
+
+void ExternalObjective::release(const std::vector<int>& taken) const {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        idle.insert(idle.end(), taken.begin(), taken.end());
+    }
+    available.notify_all();
+}
+
+void ExternalObjective::retire(const std::vector<int>& taken) const {
+    for (int w : taken) {
+        Worker& worker = workers[w];
+        close(worker.input);
+        close(worker.output);
+        kill(worker.pid, SIGKILL);
+        int status;
+        while (waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {}
+        worker.pid = -1;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        alive -= static_cast<int>(taken.size());
+    }
+    // 唤醒等待中的调用者，没有工作进程剩下时它们抛出异常
+    available.notify_all();
+}
+
+Scalar ExternalObjective::eval(const std::vector<Scalar>& x) const {
+    Scalar f;
+    evalBatch(x.data(), 1, dimension, &f);
+    return f;
+}
+
+void ExternalObjective::evalBatch(const Scalar* X, int n, int dim, Scalar* out) const {
+    if (n <= 0) return;
+    // Scalar 为 double 时直接收发调用者的缓冲区，否则经过线程局部的 double 缓冲区转换
+    const bool direct = std::is_same<Scalar, double>::value;
+    thread_local std::vector<double> request;
+    thread_local std::vector<double> reply;
+    const double* points = reinterpret_cast<const double*>(X);
+    double* values = reinterpret_cast<double*>(out);
+    if (!direct) {
+        request.assign(X, X + static_cast<size_t>(n) * dim);
+        reply.resize(n);
+        points = request.data();
+        values = reply.data();
+    }
+    thread_local std::vector<int> taken;
+    thread_local std::vector<int> failed;
+    acquire(n, taken);
+    int k = static_cast<int>(taken.size());
+    failed.clear();
+    std::string error;
+    // 先把各段请求全部发出，工作进程在读取应答之前就已并行计算。
+    // 某个工作进程出错时，仍然读完其余工作进程的应答，使它们的管道保持同步，可以放回进程池
+    std::vector<char>& ok = okFlags(k);
+    {
+        SigpipeBlock block;
+        for (int c = 0; c < k; ++c) {
+            int begin = static_cast<int>(static_cast<long long>(n) * c / k);
+            int end = static_cast<int>(static_cast<long long>(n) * (c + 1) / k);
+            uint32_t header[2] = { static_cast<uint32_t>(end - begin), static_cast<uint32_t>(dim) };
+            struct iovec iov[2] = {
+                { header, sizeof(header) },
+                { const_cast<double*>(points + static_cast<size_t>(begin) * dim), static_cast<size_t>(end - begin) * dim * sizeof(double) },
+            };
+            try {
+                writeAll(workers[taken[c]].input, iov, 2);
+                ok[c] = 1;
+            } catch (const std::exception& e) {
+                ok[c] = 0;
+                if (error.empty()) error = e.what();
+            }
+        }
+    }
+    for (int c = 0; c < k; ++c) {
+        int begin = static_cast<int>(static_cast<long long>(n) * c / k);
+        int end = static_cast<int>(static_cast<long long>(n) * (c + 1) / k);
+        if (ok[c]) {
+            try {
+                readAll(workers[taken[c]].output, values + begin, static_cast<size_t>(end - begin) * sizeof(double));
+            } catch (const std::exception& e) {
+                ok[c] = 0;
+                if (error.empty()) error = e.what();
+            }
+        }
+        if (!ok[c]) failed.push_back(taken[c]);
+    }
+    if (!failed.empty()) {
+        // 出错的工作进程管道中可能还有未读的数据，结束它们并移出进程池，其余的放回
+        taken.erase(std::remove_if(taken.begin(), taken.end(), [](int w) {
+            return std::find(failed.begin(), failed.end(), w) != failed.end();
+        }), taken.end());
+        retire(failed);
+        release(taken);
+        throw std::runtime_error(error);
+    }
+    if (!direct) std::copy(reply.begin(), reply.end(), out);
+    release(taken);
+}
@@ -0,0 +1,64 @@
+#ifndef EXTERNAL_OBJECTIVE_H
+#define EXTERNAL_OBJECTIVE_H
+
+#include "ObjectiveFunction.h"
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+// 由外部进程计算的目标函数（例如以独立程序运行的仿真器）。
+// 构造时启动 workers 个常驻的工作进程，通过管道与它们通信，协议为本机字节序的二进制消息：
+//   请求：uint32 count, uint32 dim, 随后 count * dim 个 double（逐点连续存放）
+//   应答：count 个 double，即各点的目标函数值
+// 工作进程从标准输入读请求、向标准输出写应答，读到 EOF 时退出，示例见 worker/objective_worker.cpp。
+// evalBatch 把一批点分给所有空闲的工作进程，先发出全部请求再读取应答，各进程同时计算；
+// 每条消息的开销由一批点分摊。可以被多个线程同时调用，工作进程不够时调用者等待。
+// 协议总是使用 double，单精度构建时在发送前与接收后转换。
+// 工作进程异常退出或协议出错时抛出 std::runtime_error，出错的工作进程被结束并移出进程池
+// （管道中可能还有未读的数据），之后由其余的工作进程继续计算，全部失败后每次调用都抛出异常。
+// 向已退出的工作进程写入时，SIGPIPE 只在写入期间于本线程内屏蔽并清除，不改变进程的信号处理方式
+class ExternalObjective : public ObjectiveFunction {
+public:
+    // command 由 /bin/sh 执行；workers 为 0 时使用硬件线程数
+    ExternalObjective(const std::string& command, int dim, int workers = 0);
+    ~ExternalObjective();
+    ExternalObjective(const ExternalObjective&) = delete;
+    ExternalObjective& operator=(const ExternalObjective&) = delete;
+
+    virtual Scalar eval(const std::vector<Scalar>& x) const override;
+    virtual void evalBatch(const Scalar* X, int n, int dim, Scalar* out) const override;
+    // 子进程会与父进程及其他子进程共用工作进程的管道，请求与应答会交错
+    virtual bool forkSafe(bool) const override { return false; }
+    virtual bool prefersBatch() const override { return true; }
+
+    int getWorkers() const { return static_cast<int>(workers.size()); }
+
+private:
+    struct Worker {
+        pid_t pid;    // 已移出进程池时为 -1
+        int input;    // 写入工作进程的标准输入
+        int output;   // 读取工作进程的标准输出
+    };
+
+    std::string command;
+    int dimension;
+    // 元素只在 retire() 中修改，此时它们由调用者独占
+    mutable std::vector<Worker> workers;
+
+    mutable std::mutex mutex;
+    mutable std::condition_variable available;
+    mutable std::vector<int> idle;
+    mutable int alive = 0;
+
+    void start(int count);
+    void stop();
+    // 至少取得一个、至多 wanted 个空闲的工作进程
+    void acquire(int wanted, std::vector<int>& out) const;
+    void release(const std::vector<int>& taken) const;
+    // 结束出错的工作进程并移出进程池
+    void retire(const std::vector<int>& taken) const;
+};
+
+#endif // EXTERNAL_OBJECTIVE_H
@@ -0,0 +1,298 @@
+#include "Factory.h"
+#include "RastriginFunction.h"
+#include "MichalewiczFunction.h"
+#include "SphereFunction.h"
+#include "AckleyFunction.h"
+#include "RosenbrockFunction.h"
+#include "GriewankFunction.h"
+#include "SchwefelFunction.h"
+#include "TransformedFunction.h"
+#include "ExternalObjective.h"
+#include "SA.h"
+#include "GA.h"
+#include "PSO.h"
+#include "DE.h"
+#include "IslandDE.h"
+#include "SteadyStateGA.h"
+#include "SteadyStateDE.h"
+#include "PT.h"
+#include "Portfolio.h"
+#include "CMAES.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cmath>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+// 测试函数的默认区间，以及最优解所在的坐标（平移/旋转时以它为中心）
+struct FunctionInfo {
+    const char* name;
+    double xmin;
+    double xmax;
+    double center;
+    bool transformable;   // Michalewicz 的最优解没有解析形式，不提供平移/旋转版本
+};
+
+const FunctionInfo FUNCTIONS[] = {
+    {"rastrigin", -5.12, 5.12, 0.0, true},
+    {"michalewicz", 0.0, M_PI, 0.0, false},
+    {"sphere", -100.0, 100.0, 0.0, true},
+    {"ackley", -32.768, 32.768, 0.0, true},
+    {"rosenbrock", -5.0, 10.0, 1.0, true},
+    {"griewank", -600.0, 600.0, 0.0, true},
+    {"schwefel", -500.0, 500.0, SchwefelFunction::OPTIMUM, true},
+};
+
+// 旋转矩阵的分块大小，D <= 100 时为完整旋转
+const int ROTATION_BLOCK = 100;
+
+// 名称可以带 shifted_ 或 shifted_rotated_ 前缀，返回去掉前缀后的测试函数
+const FunctionInfo& parseName(const std::string& name, bool& shifted, bool& rotated) {
+    std::string n = lower(name);
+    shifted = rotated = false;
+    if (n.compare(0, 16, "shifted_rotated_") == 0) {
+        shifted = rotated = true;
+        n = n.substr(16);
+    } else if (n.compare(0, 8, "shifted_") == 0) {
+        shifted = true;
+        n = n.substr(8);
+    }
+    for (const auto& info : FUNCTIONS) {
+        if (n == info.name && (info.transformable || !shifted)) return info;
+    }
+    throw std::invalid_argument("unknown function '" + name + "'");
+}
+
+std::unique_ptr<ObjectiveFunction> createBase(const std::string& n, int dim) {
+    if (n == "rastrigin") return std::unique_ptr<ObjectiveFunction>(new RastriginFunction(dim));
+    if (n == "michalewicz") return std::unique_ptr<ObjectiveFunction>(new MichalewiczFunction(dim));
+    if (n == "sphere") return std::unique_ptr<ObjectiveFunction>(new SphereFunction(dim));
+    if (n == "ackley") return std::unique_ptr<ObjectiveFunction>(new AckleyFunction(dim));
+    if (n == "rosenbrock") return std::unique_ptr<ObjectiveFunction>(new RosenbrockFunction(dim));
+    if (n == "griewank") return std::unique_ptr<ObjectiveFunction>(new GriewankFunction(dim));
+    return std::unique_ptr<ObjectiveFunction>(new SchwefelFunction(dim));
+}
+
+// 由函数名与维数得到固定的随机数种子，同一个测试实例在每次运行中都相同
+uint64_t instanceSeed(const std::string& name, int dim, uint64_t salt) {
+    uint64_t h = 1469598103934665603ULL;
+    for (char c : name) {
+        h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+    return h ^ (static_cast<uint64_t>(dim) << 32) ^ salt;
+}
+
+std::string upper(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::toupper(c); });
+    return s;
+}
+
+// 取参数值并检查参数名是否都属于该算法
+class ParameterReader {
+public:
+    ParameterReader(const std::string& algorithm, const ParameterSet& params) : algorithm(algorithm), params(params) {}
+
+    double get(const std::string& name, double defaultValue) {
+        known.insert(name);
+        auto it = params.find(name);
+        return it == params.end() ? defaultValue : it->second;
+    }
+
+    // 取值须在 [lo, hi] 内（NaN 也不合法），先于转换为整数检查
+    double get(const std::string& name, double defaultValue, double lo, double hi = HUGE_VAL) {
+        double value = get(name, defaultValue);
+        require(name, value >= lo && value <= hi,
+                hi == HUGE_VAL ? "at least " + format(lo) : "between " + format(lo) + " and " + format(hi));
+        return value;
+    }
+
+    // 整数参数：取值须不小于 lo，且能表示为 int
+    int integer(const std::string& name, double defaultValue, int lo) {
+        double value = get(name, defaultValue);
+        require(name, value >= lo && value <= INT_MAX, "at least " + format(lo));
+        return static_cast<int>(value);
+    }
+
+    double positive(const std::string& name, double defaultValue) {
+        double value = get(name, defaultValue);
+        require(name, value > 0 && value < HUGE_VAL, "positive");
+        return value;
+    }
+
+    void require(const std::string& name, bool ok, const std::string& what) const {
+        if (!ok) throw ParameterError(name, algorithm + " " + name + " must be " + what);
+    }
+
+    void checkUnknown() const {
+        for (const auto& kv : params) {
+            if (!known.count(kv.first)) {
+                throw ParameterError(kv.first, "unknown parameter '" + kv.first + "' for " + algorithm);
+            }
+        }
+    }
+
+private:
+    static std::string format(double value) {
+        std::ostringstream out;
+        out << value;
+        return out.str();
+    }
+
+    std::string algorithm;
+    const ParameterSet& params;
+    std::set<std::string> known;
+};
+
+}
+
+std::unique_ptr<ObjectiveFunction> createObjective(const std::string& name, int dim) {
+    if (dim <= 0) throw std::invalid_argument("dimension must be positive");
+    bool shifted, rotated;
+    const FunctionInfo& info = parseName(name, shifted, rotated);
+    std::unique_ptr<ObjectiveFunction> base = createBase(info.name, dim);
+    if (!shifted) return base;
+
+    auto shift = sharedShift(dim, info.xmin, info.xmax, instanceSeed(info.name, dim, 1));
+    if (!rotated) {
+        if (auto* separable = dynamic_cast<SeparableObjective*>(base.get())) {
+            base.release();
+            return std::unique_ptr<ObjectiveFunction>(new ShiftedSeparableFunction(
+                std::unique_ptr<SeparableObjective>(separable), shift, info.center));
+        }
+        return std::unique_ptr<ObjectiveFunction>(new ShiftedRotatedFunction(std::move(base), shift, nullptr, info.center));
+    }
+    auto rotation = sharedRotation(dim, ROTATION_BLOCK, instanceSeed(info.name, dim, 2));
+    return std::unique_ptr<ObjectiveFunction>(new ShiftedRotatedFunction(std::move(base), shift, rotation, info.center));
+}
+
+std::unique_ptr<ObjectiveFunction> createExternalObjective(const std::string& command, int dim, int workers) {
+    return std::unique_ptr<ObjectiveFunction>(new ExternalObjective(command, dim, workers));
+}
+
+void defaultBounds(const std::string& name, double& xmin, double& xmax) {
+    bool shifted, rotated;
+    const FunctionInfo& info = parseName(name, shifted, rotated);
+    xmin = info.xmin;
+    xmax = info.xmax;
+}
+
+std::unique_ptr<Optimizer> createOptimizer(const std::string& algorithm, const ObjectiveFunction& objFunc,
+                                           int dim, double xmin, double xmax, const ParameterSet& params) {
+    std::string a = upper(algorithm);
+    ParameterReader p(a, params);
+    if (dim <= 0) throw ParameterError("dim", "dimension must be positive");
+    if (!(xmin < xmax) || !std::isfinite(xmin) || !std::isfinite(xmax)) {
+        throw ParameterError("x_min", "x_min must be less than x_max and both finite");
+    }
+    int maxGen = p.integer("max_gen", 500, 0);
+    int popSize = p.integer("pop_size", 50, 1);
+    // 所有算法通用的评估次数上限，0 表示只受 max_gen 限制
+    long long maxEvals = static_cast<long long>(p.get("max_evals", 0, 0, 1e18));
+    // 通用的终止条件，0 表示不启用；target 未给出时不启用
+    double maxTime = p.get("max_time", 0, 0);
+    double target = p.get("target", -HUGE_VAL);
+    int stagnation = p.integer("stagnation", 0, 0);
+    double stagnationTol = p.get("stagnation_tol", 0, 0);
+    double minDiversity = p.get("min_diversity", 0, 0);
+    std::unique_ptr<Optimizer> optimizer;
+    if (a == "SA") {
+        optimizer.reset(new SA(objFunc, dim, maxGen, xmin, xmax,
+                               p.positive("initial_temp", 100.0), p.get("cooling_rate", 0.99, 0, 1)));
+    } else if (a == "GA") {
+        // 锦标赛与单点交叉至少需要两个个体
+        p.require("pop_size", popSize >= 2, "at least 2");
+        double mutationRate = p.get("mutation_rate", 0.1, 0, 1);
+        double crossoverRate = p.get("crossover_rate", 0.8, 0, 1);
+        // steady_state = 1 时为稳态异步版本，评估在线程池上进行，适合评估耗时长且不均匀的目标函数
+        if (p.get("steady_state", 0) != 0) {
+            optimizer.reset(new SteadyStateGA(objFunc, dim, popSize, maxGen, xmin, xmax, mutationRate, crossoverRate));
+        } else {
+            optimizer.reset(new GA(objFunc, dim, popSize, maxGen, xmin, xmax, mutationRate, crossoverRate));
+        }
+    } else if (a == "PSO") {
+        // topology: 0 全局, 1 环形, 2 冯·诺依曼, 3 随机 k（k 由 neighbors 给出）
+        int topology = static_cast<int>(p.get("topology", 0, PSO::Global, PSO::RandomK));
+        optimizer.reset(new PSO(objFunc, dim, popSize, maxGen, xmin, xmax,
+                                p.get("w", 0.5), p.get("c1", 1.5), p.get("c2", 1.5),
+                                p.get("synchronous", 0) != 0, static_cast<PSO::Topology>(topology),
+                                p.integer("neighbors", 3, 1)));
+    } else if (a == "DE") {
+        // islands > 1 时为岛屿模型，pop_size 为各岛个体数之和；topology: 0 单向环, 1 双向环, 2 全连接
+        int islands = p.integer("islands", 1, 1);
+        int migrationInterval = p.integer("migration_interval", 20, 1);
+        int migrants = p.integer("migrants", 2, 1);
+        int topology = static_cast<int>(p.get("topology", 0, IslandDE::Ring, IslandDE::Complete));
+        bool processes = p.get("processes", 0) != 0;
+        bool steadyState = p.get("steady_state", 0) != 0;
+        double F = p.get("F", 0.5, 0, 2);
+        double CR = p.get("CR", 0.9, 0, 1);
+        // 变异需要三个互不相同且不同于目标个体的个体
+        p.require("pop_size", popSize >= 4 * static_cast<long long>(islands), islands > 1 ? "at least 4 per island" : "at least 4");
+        if (steadyState && islands > 1) {
+            throw ParameterError("steady_state", "DE steady_state cannot be combined with islands");
+        }
+        if (steadyState) {
+            optimizer.reset(new SteadyStateDE(objFunc, dim, popSize, maxGen, F, CR, xmin, xmax));
+        } else if (islands > 1) {
+            optimizer.reset(new IslandDE(objFunc, dim, popSize, maxGen, F, CR, xmin, xmax,
+                                         islands, migrationInterval, migrants, static_cast<IslandDE::Topology>(topology), processes));
+        } else {
+            optimizer.reset(new DE(objFunc, dim, popSize, maxGen, F, CR, xmin, xmax));
+        }
+    } else if (a == "PT") {
+        // max_gen 为每个副本的步数，副本在运行内部的线程池上并行
+        double minTemp = p.positive("min_temp", 0.01);
+        double maxTemp = p.get("max_temp", 100.0, minTemp);
+        optimizer.reset(new PT(objFunc, dim, maxGen, xmin, xmax, p.integer("replicas", 8, 1), minTemp, maxTemp,
+                               p.integer("exchange_interval", 100, 1), p.get("adaptive", 1) != 0));
+    } else if (a == "CMAES") {
+        // 合计 pop_size * (max_gen + 1) 次评估，与分代算法相同；lambda 为 0 时取默认的 4 + 3 ln D，
+        // 每次重启加倍；separable = 1 时只维护对角协方差
+        optimizer.reset(new CMAES(objFunc, dim, static_cast<long long>(popSize) * (maxGen + 1), xmin, xmax,
+                                  p.integer("lambda", 0, 0), p.positive("sigma", 0.3),
+                                  p.integer("restarts", 9, 0), p.get("separable", 0) != 0));
+    } else if (a == "PORTFOLIO") {
+        // SA、GA、PSO、DE 同时运行，各自使用默认参数（GA/PSO/DE 的种群大小为 pop_size），
+        // 合计 pop_size * (max_gen + 1) 次评估，与分代算法相同
+        std::vector<std::unique_ptr<Optimizer>> members;
+        std::vector<std::string> names = {"SA", "GA", "PSO", "DE"};
+        for (const auto& name : names) {
+            ParameterSet memberParams;
+            if (name != "SA") memberParams["pop_size"] = popSize;
+            members.push_back(createOptimizer(name, objFunc, dim, xmin, xmax, memberParams));
+        }
+        optimizer.reset(new Portfolio(std::move(members), names, dim, static_cast<long long>(popSize) * (maxGen + 1),
+                                      p.integer("round_evals", 1000, 1), p.get("min_share", 0.05, 0, 1.0 / names.size()),
+                                      p.get("decay", 0.5, 0, 1)));
+    } else {
+        throw std::invalid_argument("unknown algorithm '" + algorithm + "'");
+    }
+    p.checkUnknown();
+    optimizer->setMaxEvaluations(maxEvals);
+    if (maxTime > 0) optimizer->addTermination(std::unique_ptr<TerminationCriterion>(new WallTimeLimit(maxTime)));
+    if (std::isfinite(target)) optimizer->addTermination(std::unique_ptr<TerminationCriterion>(new TargetFitness(target)));
+    if (stagnation > 0) optimizer->addTermination(std::unique_ptr<TerminationCriterion>(new Stagnation(stagnation, stagnationTol)));
+    if (minDiversity > 0) optimizer->addTermination(std::unique_ptr<TerminationCriterion>(new DiversityCollapse(minDiversity)));
+    return optimizer;
+}
+
+std::string algorithmTitle(const std::string& algorithm) {
+    std::string a = upper(algorithm);
+    if (a == "SA") return "Simulated Annealing";
+    if (a == "GA") return "Genetic Algorithm";
+    if (a == "PSO") return "Particle Swarm Optimization";
+    if (a == "DE") return "Differential Evolution";
+    if (a == "PT") return "Parallel Tempering";
+    if (a == "CMAES") return "CMA-ES";
+    if (a == "PORTFOLIO") return "Algorithm Portfolio";
+    return algorithm;
+}
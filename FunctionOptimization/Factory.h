@@ -0,0 +1,41 @@
+#ifndef FACTORY_H
+#define FACTORY_H
+
+#include "ObjectiveFunction.h"
+#include "Optimizer.h"
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// 按名称创建目标函数与优化算法，供实验配置文件使用
+typedef std::map<std::string, double> ParameterSet;
+
+// 名称不区分大小写，未知名称抛出 std::invalid_argument。
+// 测试函数：rastrigin, michalewicz, sphere, ackley, rosenbrock, griewank, schwefel，
+// 除 michalewicz 外都可以加 shifted_ 或 shifted_rotated_ 前缀得到 CEC 风格的变体
+std::unique_ptr<ObjectiveFunction> createObjective(const std::string& name, int dim);
+// 由 workers 个外部工作进程计算的目标函数，command 由 /bin/sh 执行，协议见 ExternalObjective.h
+std::unique_ptr<ObjectiveFunction> createExternalObjective(const std::string& command, int dim, int workers);
+// 目标函数的默认搜索区间
+void defaultBounds(const std::string& name, double& xmin, double& xmax);
+
+// 参数名未知或取值超出范围时抛出，parameter() 为出错的参数名，供配置文件报告出错的行
+class ParameterError : public std::invalid_argument {
+public:
+    ParameterError(const std::string& parameter, const std::string& message)
+        : std::invalid_argument(message), name(parameter) {}
+    const std::string& parameter() const { return name; }
+
+private:
+    std::string name;
+};
+
+// 未给出的参数取默认值；未知的参数名或超出范围的取值抛出 ParameterError，
+// dim、x_min、x_max 分别以 "dim"、"x_min" 为参数名
+std::unique_ptr<Optimizer> createOptimizer(const std::string& algorithm, const ObjectiveFunction& objFunc,
+                                           int dim, double xmin, double xmax, const ParameterSet& params);
+// 算法全称，用于统计文件的标题
+std::string algorithmTitle(const std::string& algorithm);
+
+#endif // FACTORY_H
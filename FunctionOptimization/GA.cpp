@@ -3,39 +3,67 @@
 #include <cmath>
 
 GA::GA(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax, double mutationRate, double crossoverRate)
-    : objFunc(objFunc), DIM(dim), POP_SIZE(popSize), MAX_GEN(maxGen), X_MIN(xmin), X_MAX(xmax),
-      mutationRate(mutationRate), crossoverRate(crossoverRate), gen(rd()), dis(0.0, 1.0)
+    : objFunc(objFunc), separable(dynamic_cast<const SeparableObjective*>(&objFunc)), DIM(dim), POP_SIZE(popSize), MAX_GEN(maxGen), X_MIN(xmin), X_MAX(xmax),
+      mutationRate(mutationRate), crossoverRate(crossoverRate), batched(objFunc.prefersBatch()), gen(rd()), dis(0.0, 1.0)
 {
+    // 种群与子代缓冲区在构造时一次分配好，每代结束时交换二者
     population.resize(POP_SIZE);
+    offspring.resize(POP_SIZE);
+    for (int i = 0; i < POP_SIZE; ++i) {
+        population[i].position.resize(DIM);
+        offspring[i].position.resize(DIM);
+    }
+    changed.resize(DIM);
+    if (batched) {
+        batchX.resize(static_cast<size_t>(POP_SIZE) * DIM);
+        batchFitness.resize(POP_SIZE);
+        batchIndex.resize(POP_SIZE);
+    }
 }
 
 void GA::initializePopulation() {
     std::uniform_real_distribution<> dis_x(X_MIN, X_MAX);
-    for (auto& ind : population) {
-        ind.position.resize(DIM);
-        for (auto& xi : ind.position) {
+    for (int i = 0; i < POP_SIZE; ++i) {
+        for (auto& xi : population[i].position) {
             xi = dis_x(gen);
         }
-        ind.fitness = objFunc.eval(ind.position);
+        if (batched) batchIndex[i] = i;
+        else population[i].fitness = objFunc.eval(population[i].position);
     }
+    if (batched) evaluateBatch(population, POP_SIZE);
+    evaluations = POP_SIZE;
 }
 
-Individual GA::selectParent() {
-    // 简单锦标赛选择
+// 评估 batchIndex 中前 n 个个体，一次 evalBatch，外部进程池可以同时计算
+void GA::evaluateBatch(std::vector<Individual>& individuals, int n) {
+    for (int j = 0; j < n; ++j) {
+        const Individual& ind = individuals[batchIndex[j]];
+        std::copy(ind.position.begin(), ind.position.end(), &batchX[static_cast<size_t>(j) * DIM]);
+    }
+    objFunc.evalBatch(batchX.data(), n, DIM, batchFitness.data());
+    for (int j = 0; j < n; ++j) individuals[batchIndex[j]].fitness = batchFitness[j];
+}
+
+int GA::selectParent() {
+    // 简单锦标赛选择，返回个体下标以避免复制
     int a = gen() % POP_SIZE;
     int b = gen() % POP_SIZE;
-    return (population[a].fitness < population[b].fitness) ? population[a] : population[b];
+    return fitnessLess(population[a].fitness, population[b].fitness) ? a : b;
 }
 
-Individual GA::crossover(const Individual& p1, const Individual& p2) {
-    Individual child;
-    child.position.resize(DIM);
+const Individual& GA::crossover(const Individual& p1, const Individual& p2, Individual& child) {
     int cp = gen() % DIM;
-    for (int i = 0; i < DIM; ++i) {
-        if (i < cp) child.position[i] = p1.position[i];
-        else child.position[i] = p2.position[i];
+    std::copy(p1.position.begin(), p1.position.begin() + cp, child.position.begin());
+    std::copy(p2.position.begin() + cp, p2.position.end(), child.position.begin() + cp);
+    // 返回与子代相同坐标更多的父代，子代只在 min(cp, DIM - cp) 个坐标上与它不同
+    if (2 * cp >= DIM) {
+        changeBegin = cp;
+        changeEnd = DIM;
+        return p1;
     }
-    return child;
+    changeBegin = 0;
+    changeEnd = cp;
+    return p2;
 }
 
 void GA::mutate(Individual& ind) {
@@ -43,47 +71,111 @@ void GA::mutate(Individual& ind) {
     for (int i = 0; i < DIM; ++i) {
         if (dis(gen) < mutationRate) {
             ind.position[i] = dis_x(gen);
+            if (i < changeBegin || i >= changeEnd) changed[numChanged++] = i;
         }
     }
 }
 
 void GA::evolve() {
-    std::vector<Individual> newPop;
-    newPop.reserve(POP_SIZE);
+    telemetry.startPhases();
+    Scalar parentBest = getBestIndividual().fitness;
+    int pending = 0;
     for (int i = 0; i < POP_SIZE; ++i) {
-        Individual p1 = selectParent();
-        Individual p2 = selectParent();
-        Individual child = p1;
+        const Individual& p1 = population[selectParent()];
+        const Individual& p2 = population[selectParent()];
+        telemetry.lap(Telemetry::Selection);
+        Individual& child = offspring[i];
+        const Individual* base = &p1;
         if (dis(gen) < crossoverRate) {
-            child = crossover(p1, p2);
+            base = &crossover(p1, p2, child);
+        } else {
+            std::copy(p1.position.begin(), p1.position.end(), child.position.begin());
+            changeBegin = changeEnd = 0;
         }
+        numChanged = 0;
         mutate(child);
-        child.fitness = objFunc.eval(child.position);
-        newPop.push_back(child);
+        telemetry.lap(Telemetry::Variation);
+        // 可分离时由父代适应度增量计算，改变的坐标多于一半时完整评估更便宜
+        int k = changeEnd - changeBegin + numChanged;
+        if (k == 0) {
+            // 子代与父代完全相同（未交叉也未变异），沿用父代的适应度，不计评估次数
+            child.fitness = base->fitness;
+        } else if (batched) {
+            // 留到这一代结束时成批评估
+            batchIndex[pending++] = i;
+            ++evaluations;
+        } else {
+            if (separable && 2 * k < DIM) {
+                for (int j = changeBegin; j < changeEnd; ++j) changed[numChanged++] = j;
+                child.fitness = separable->update(base->fitness, base->position, child.position, changed.data(), numChanged);
+                // 增量值带有逐代累积的舍入误差，优于父代最优时再完整计算一次，
+                // 使最优值的每次改进都是精确值，不会低于真实的最小值
+                if (fitnessLess(child.fitness, parentBest)) child.fitness = objFunc.eval(child.position);
+            } else {
+                child.fitness = objFunc.eval(child.position);
+            }
+            ++evaluations;
+        }
+        telemetry.lap(Telemetry::Evaluation);
     }
-    population = newPop;
+    if (pending > 0) {
+        evaluateBatch(offspring, pending);
+        telemetry.lap(Telemetry::Evaluation);
+    }
+    population.swap(offspring);
 }
 
-void GA::run() {
+void GA::initialize() {
     initializePopulation();
-    for (int generation = 0; generation < MAX_GEN; ++generation) {
-        evolve();
-#ifdef ENABLE_DATA_COLLECTION
-        for (int i = 0; i < POP_SIZE; ++i) {
-            std::string line = std::to_string(generation) + "," + std::to_string(i);
-            for (const auto& xi : population[i].position) {
-                line += "," + std::to_string(xi);
-            }
-            line += "," + std::to_string(population[i].fitness);
-            dataBuffer.push_back(line);
-        }
-#endif
+    startProgress();
+    telemetry.beginRun(DIM, POP_SIZE, MAX_GEN);
+}
+
+void GA::step(int generation) {
+    evolve();
+    telemetry.recordPopulation(generation, evaluations, population);
+}
+
+void GA::finish() {
+    // 没有精英保留，最终种群的最优个体可能是没有改进最优值、只经过增量计算的子代。
+    // 结束时完整计算一次，使报告的最优值精确；同一批点不再计评估
+    if (separable) {
+        for (auto& ind : population) ind.fitness = objFunc.eval(ind.position);
+    }
+    telemetry.endRun();
+}
+
+void GA::immigrate(const Scalar* position, Scalar fitness) {
+    auto worst = std::max_element(population.begin(), population.end(),
+                                  [](const Individual& a, const Individual& b) {
+                                      return fitnessLess(a.fitness, b.fitness);
+                                  });
+    if (fitnessLess(fitness, worst->fitness)) {
+        std::copy(position, position + DIM, worst->position.begin());
+        worst->fitness = fitness;
+    }
+}
+
+void GA::run() {
+    initialize();
+    for (int generation = 0; generation < MAX_GEN && !evaluationBudgetExhausted(); ++generation) {
+        step(generation);
+        if (checkProgress(generation)) break;
     }
+    finish();
+}
+
+double GA::getDiversity() const {
+    return populationDiversity(population, POP_SIZE);
+}
+
+int GA::copyPopulation(Scalar* X, Scalar* fitness, int capacity) const {
+    return copyRows(population, POP_SIZE, X, fitness, capacity);
 }
 
 const Individual& GA::getBestIndividual() const {
     return *std::min_element(population.begin(), population.end(),
                              [](const Individual& a, const Individual& b) {
-                                 return a.fitness < b.fitness;
+                                 return fitnessLess(a.fitness, b.fitness);
                              });
 }
\ No newline at end of file
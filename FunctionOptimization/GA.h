@@ -3,6 +3,7 @@
 
 #include "Optimizer.h"
 #include "ObjectiveFunction.h"
+#include "SeparableObjective.h"
 #include <vector>
 #include <random>
 
@@ -11,9 +12,20 @@ public:
     GA(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax, double mutationRate, double crossoverRate);
     virtual void run() override;
     virtual const Individual& getBestIndividual() const override;
+    virtual double getDiversity() const override;
+    virtual int copyPopulation(Scalar* X, Scalar* fitness, int capacity) const override;
+
+    // run() 即 initialize + MAX_GEN 次 step + finish
+    virtual bool steppable() const override { return true; }
+    virtual void initialize() override;
+    virtual void step(int generation) override;
+    virtual void finish() override;
+    // 迁入个体优于最差个体时替换之
+    virtual void immigrate(const Scalar* position, Scalar fitness) override;
 
 private:
     const ObjectiveFunction& objFunc;
+    const SeparableObjective* separable;   // 目标函数可分离时非空
     int DIM;
     int POP_SIZE;
     int MAX_GEN;
@@ -23,15 +35,27 @@ private:
     double crossoverRate;
 
     std::vector<Individual> population;
+    std::vector<Individual> offspring;
+    // 子代相对于较接近的父代改变的坐标：交叉得到的区间 [changeBegin, changeEnd) 与变异的坐标
+    std::vector<int> changed;
+    int numChanged;
+    int changeBegin;
+    int changeEnd;
+    // 目标函数偏好批量评估时，一代中需要评估的子代复制到 batchX，一次评估后写回 batchIndex 所指的子代
+    bool batched;
+    std::vector<Scalar> batchX;
+    std::vector<Scalar> batchFitness;
+    std::vector<int> batchIndex;
     std::random_device rd;
     std::mt19937 gen;
     std::uniform_real_distribution<> dis;
 
     void initializePopulation();
     void evolve();
-    Individual selectParent();
-    Individual crossover(const Individual& p1, const Individual& p2);
+    int selectParent();
+    const Individual& crossover(const Individual& p1, const Individual& p2, Individual& child);
     void mutate(Individual& ind);
+    void evaluateBatch(std::vector<Individual>& individuals, int n);
 };
 
 #endif // GA_H
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef GRIEWANK_FUNCTION_H
+#define GRIEWANK_FUNCTION_H
+
+#include "ObjectiveFunction.h"
+#include <cmath>
+
+// 原式为 Σx²/4000 - Π cos(x_i/√i) + 1。记 a_i = 1 - cos(x_i/√i) = 2 sin²(x_i/(2√i))，
+// 1 - Π(1 - a_i) 按 q ← q + a - q a 逐项累积，最优解附近不会由接近 1 的乘积与 1 相减，单精度下仍能精确到 0
+class GriewankFunction : public ObjectiveFunction {
+public:
+    GriewankFunction(int dim): dimension(dim) {}
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        Scalar sum = 0;
+        Scalar q = 0;
+        for (int i = 0; i < dimension; ++i) {
+            Scalar s = std::sin(x[i] / (2 * std::sqrt(static_cast<Scalar>(i + 1))));
+            Scalar a = 2 * s * s;
+            sum += x[i] * x[i];
+            q += a - q * a;
+        }
+        return sum / 4000 + q;
+    }
+
+private:
+    int dimension;
+};
+
+#endif // GRIEWANK_FUNCTION_H
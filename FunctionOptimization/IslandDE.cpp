@@ -0,0 +1,294 @@
+#include "IslandDE.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+// 每条边的队列能容纳几批迁出个体
+const int QUEUED_BATCHES = 2;
+
+size_t alignUp(size_t bytes) {
+    return (bytes + 63) / 64 * 64;
+}
+}
+
+IslandDE::IslandDE(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double F, double CR, double xmin, double xmax,
+                   int islands, int migrationInterval, int migrants, Topology topology, bool processes)
+    : objFunc(objFunc), DIM(dim), MAX_GEN(maxGen), ISLANDS(std::max(1, islands)), MIGRATION_INTERVAL(std::max(1, migrationInterval)),
+      MIGRANTS(std::max(1, migrants)), topology(topology), processes(processes), bestIsland(-1)
+{
+    // DE 的变异需要目标个体之外的 3 个不同个体
+    if (popSize / ISLANDS < 4) {
+        throw std::invalid_argument("island DE needs at least 4 individuals per island");
+    }
+    for (int i = 0; i < ISLANDS; ++i) {
+        islandSize.push_back(popSize / ISLANDS + (i < popSize % ISLANDS ? 1 : 0));
+        this->islands.emplace_back(new DE(objFunc, dim, islandSize[i], maxGen, F, CR, xmin, xmax));
+        order.emplace_back(islandSize[i]);
+    }
+    MIGRANTS = std::min(MIGRANTS, islandSize.back());
+    buildTopology();
+    best.position.resize(DIM);
+}
+
+void IslandDE::buildTopology() {
+    std::set<std::pair<int, int>> edges;
+    for (int i = 0; i < ISLANDS; ++i) {
+        if (topology == Complete) {
+            for (int j = 0; j < ISLANDS; ++j) {
+                if (j != i) edges.insert({i, j});
+            }
+            continue;
+        }
+        if (ISLANDS > 1) edges.insert({i, (i + 1) % ISLANDS});
+        if (topology == BidirectionalRing && ISLANDS > 2) edges.insert({i, (i + ISLANDS - 1) % ISLANDS});
+    }
+    outgoing.assign(ISLANDS, std::vector<int>());
+    incoming.assign(ISLANDS, std::vector<int>());
+    for (const auto& e : edges) {
+        outgoing[e.first].push_back(static_cast<int>(edgeFrom.size()));
+        incoming[e.second].push_back(static_cast<int>(edgeFrom.size()));
+        edgeFrom.push_back(e.first);
+        edgeTo.push_back(e.second);
+    }
+}
+
+size_t IslandDE::ringBytes() const {
+    return alignUp(BlockRing::bytesRequired(QUEUED_BATCHES * MIGRANTS, DIM + 1)) * edgeFrom.size();
+}
+
+void IslandDE::createRings(char* memory) {
+    // 每个队列的槽位是 [fitness, x_0, ..., x_{D-1}]，起始地址按缓存行对齐
+    size_t bytes = alignUp(BlockRing::bytesRequired(QUEUED_BATCHES * MIGRANTS, DIM + 1));
+    rings.clear();
+    rings.reserve(edgeFrom.size());
+    for (size_t e = 0; e < edgeFrom.size(); ++e) {
+        rings.emplace_back(memory + e * bytes, QUEUED_BATCHES * MIGRANTS, DIM + 1);
+    }
+}
+
+void IslandDE::emigrate(int island) {
+    const std::vector<Individual>& population = islands[island]->getPopulation();
+    std::vector<int>& idx = order[island];
+    std::iota(idx.begin(), idx.end(), 0);
+    std::partial_sort(idx.begin(), idx.begin() + MIGRANTS, idx.end(),
+                      [&population](int a, int b) { return fitnessLess(population[a].fitness, population[b].fitness); });
+    for (int e : outgoing[island]) {
+        for (int m = 0; m < MIGRANTS; ++m) {
+            double* slot = rings[e].acquire();
+            if (!slot) break;
+            const Individual& ind = population[idx[m]];
+            slot[0] = ind.fitness;
+            std::copy(ind.position.begin(), ind.position.end(), slot + 1);
+            rings[e].publish();
+        }
+    }
+}
+
+void IslandDE::immigrate(int island) {
+    for (int e : incoming[island]) {
+        while (const double* slot = rings[e].peek()) {
+            // 队列中按 double 存放，转换为 Scalar 后交给岛上的 DE
+            thread_local std::vector<Scalar> migrant;
+            migrant.assign(slot + 1, slot + 1 + DIM);
+            islands[island]->immigrate(migrant.data(), static_cast<Scalar>(slot[0]));
+            rings[e].release();
+        }
+    }
+}
+
+void IslandDE::evolveIslands(int begin, int end, int fromGen, int toGen) {
+    // 同一线程上的几个岛逐代交错推进，使它们之间的迁移也能双向进行
+    if (fromGen == 0) {
+        for (int i = begin; i < end; ++i) islands[i]->initialize();
+    }
+    for (int generation = fromGen; generation < toGen; ++generation) {
+        for (int i = begin; i < end; ++i) {
+            if (islands[i]->evaluationBudgetExhausted()) continue;
+            islands[i]->step(generation);
+            if ((generation + 1) % MIGRATION_INTERVAL == 0) emigrate(i);
+            immigrate(i);
+        }
+    }
+    if (toGen == MAX_GEN) {
+        for (int i = begin; i < end; ++i) islands[i]->finish();
+    }
+}
+
+void IslandDE::runThreads() {
+    char* memory = static_cast<char*>(::operator new(ringBytes(), std::align_val_t(64)));
+    createRings(memory);
+    // 线程池忙于其他任务时，调用线程会依次执行所有分段；若一次跑完全部代数，先跑完的岛收不到后面的岛的个体。
+    // 因此每个迁移周期调用一次 parallelFor，各岛之间最多相差一个周期，周期内的迁移仍是异步的
+    int chunks = pool ? std::min(pool->size(), ISLANDS) : 1;
+    try {
+        for (int fromGen = 0; fromGen < MAX_GEN; fromGen += MIGRATION_INTERVAL) {
+            int toGen = std::min(MAX_GEN, fromGen + MIGRATION_INTERVAL);
+            auto body = [this, fromGen, toGen](int, int begin, int end) { evolveIslands(begin, end, fromGen, toGen); };
+            if (chunks > 1) pool->parallelFor(ISLANDS, chunks, body);
+            else body(0, 0, ISLANDS);
+            if (progressActive()) {
+                updateBest();
+                if (checkProgress(toGen - 1)) {
+                    if (toGen < MAX_GEN) {
+                        for (auto& island : islands) island->finish();
+                    }
+                    break;
+                }
+            }
+        }
+    } catch (...) {
+        rings.clear();
+        ::operator delete(memory, std::align_val_t(64));
+        throw;
+    }
+    rings.clear();
+    ::operator delete(memory, std::align_val_t(64));
+
+    updateBest();
+
+    std::vector<const std::vector<GenerationStats>*> parts;
+    for (const auto& island : islands) parts.push_back(&island->getTelemetry().getStats());
+    telemetry.mergeStats(parts, islandSize);
+}
+
+void IslandDE::runProcesses() {
+    // 共享内存依次存放：各边的队列、各岛的结果 [fitness, evaluations, 统计的代数, x...]、各岛的逐代统计
+    size_t resultSize = DIM + 3;
+    size_t resultOffset = ringBytes();
+    size_t statsOffset = resultOffset + alignUp(ISLANDS * resultSize * sizeof(double));
+    size_t statsCount = telemetry.isEnabled() ? static_cast<size_t>(MAX_GEN) : 0;
+    size_t bytes = statsOffset + ISLANDS * statsCount * sizeof(GenerationStats);
+    void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) throw std::runtime_error("cannot map shared memory for island processes");
+    char* memory = static_cast<char*>(mapped);
+    createRings(memory);
+    double* results = reinterpret_cast<double*>(memory + resultOffset);
+    GenerationStats* stats = reinterpret_cast<GenerationStats*>(memory + statsOffset);
+
+    // 子进程中只有调用 fork 的线程，岛上的 DE 不使用线程池。其他线程在 fork 时持有的锁在子进程中永远不会释放，
+    // 因此 run() 只接受 forkSafe 的目标函数；子进程会分配内存（遥测、迁移），glibc 在 fork 时重置了 malloc 的锁
+    std::vector<pid_t> children;
+    bool forkFailed = false;
+    for (int i = 0; i < ISLANDS; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            forkFailed = true;
+            break;
+        }
+        if (pid == 0) {
+            int status = 0;
+            try {
+                evolveIslands(i, i + 1, 0, MAX_GEN);
+                const Individual& b = islands[i]->getBestIndividual();
+                double* r = results + i * resultSize;
+                r[0] = b.fitness;
+                r[1] = static_cast<double>(islands[i]->getEvaluationCount());
+                const std::vector<GenerationStats>& s = islands[i]->getTelemetry().getStats();
+                size_t generations = std::min(s.size(), statsCount);
+                r[2] = static_cast<double>(generations);
+                std::copy(b.position.begin(), b.position.end(), r + 3);
+                std::copy(s.begin(), s.begin() + generations, stats + i * statsCount);
+            } catch (...) {
+                status = 1;
+            }
+            _exit(status);
+        }
+        children.push_back(pid);
+    }
+    if (forkFailed) {
+        for (pid_t pid : children) kill(pid, SIGKILL);
+    }
+    bool failed = forkFailed;
+    for (pid_t pid : children) {
+        int status;
+        if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) failed = true;
+    }
+    if (failed) {
+        rings.clear();
+        munmap(mapped, bytes);
+        throw std::runtime_error(forkFailed ? "cannot start island processes" : "an island process failed");
+    }
+
+    int bestResult = 0;
+    evaluations = 0;
+    for (int i = 0; i < ISLANDS; ++i) {
+        evaluations += static_cast<long long>(results[i * resultSize + 1]);
+        if (fitnessLess(static_cast<Scalar>(results[i * resultSize]), static_cast<Scalar>(results[bestResult * resultSize]))) bestResult = i;
+    }
+    best.fitness = results[bestResult * resultSize];
+    std::copy(results + bestResult * resultSize + 3, results + (bestResult + 1) * resultSize, best.position.begin());
+    bestIsland = -1;
+
+    std::vector<std::vector<GenerationStats>> islandStats(ISLANDS);
+    std::vector<const std::vector<GenerationStats>*> parts;
+    for (int i = 0; i < ISLANDS; ++i) {
+        islandStats[i].assign(stats + i * statsCount, stats + i * statsCount + static_cast<size_t>(results[i * resultSize + 2]));
+        parts.push_back(&islandStats[i]);
+    }
+    telemetry.mergeStats(parts, islandSize);
+    rings.clear();
+    munmap(mapped, bytes);
+}
+
+void IslandDE::run() {
+    // 各岛的遥测分别记录，运行结束后合并，种群快照不支持岛屿模型；评估次数上限平均分给各岛
+    for (auto& island : islands) {
+        island->getTelemetry().setEnabled(telemetry.isEnabled());
+        island->setMaxEvaluations(maxEvaluations > 0 ? (maxEvaluations + ISLANDS - 1) / ISLANDS : 0);
+    }
+    bestIsland = -1;
+    if (processes && !objFunc.forkSafe(pool && pool->size() > 1)) {
+        throw std::invalid_argument("island processes cannot use an external or callback objective, "
+                                    "or a cached objective while other threads are running");
+    }
+    startProgress();
+    telemetry.beginRun(DIM, std::accumulate(islandSize.begin(), islandSize.end(), 0), MAX_GEN);
+    if (processes) runProcesses();
+    else runThreads();
+    telemetry.endRun();
+}
+
+void IslandDE::updateBest() {
+    bestIsland = 0;
+    evaluations = 0;
+    for (int i = 0; i < ISLANDS; ++i) {
+        evaluations += islands[i]->getEvaluationCount();
+        if (fitnessLess(islands[i]->getBestIndividual().fitness, islands[bestIsland]->getBestIndividual().fitness)) bestIsland = i;
+    }
+}
+
+double IslandDE::getDiversity() const {
+    int n = std::accumulate(islandSize.begin(), islandSize.end(), 0);
+    return rmsDistance([this](int i) {
+        int k = 0;
+        while (i >= islandSize[k]) i -= islandSize[k++];
+        return islands[k]->getPopulation()[i].position.data();
+    }, n, DIM);
+}
+
+int IslandDE::copyPopulation(Scalar* X, Scalar* fitness, int capacity) const {
+    // 多进程模式下各岛的种群只在子进程中，只能给出最优解
+    if (processes) return Optimizer::copyPopulation(X, fitness, capacity);
+    // 容量不足时只累计个体数：X 可以为空指针（只查询大小），不能再对它做指针运算
+    int total = 0;
+    for (size_t i = 0; i < islands.size(); ++i) {
+        if (capacity > total) total += islands[i]->copyPopulation(X + static_cast<size_t>(total) * DIM, fitness + total, capacity - total);
+        else total += islandSize[i];
+    }
+    return total;
+}
+
+const Individual& IslandDE::getBestIndividual() const {
+    return bestIsland >= 0 ? islands[bestIsland]->getBestIndividual() : best;
+}
@@ -0,0 +1,64 @@
+#ifndef ISLAND_DE_H
+#define ISLAND_DE_H
+
+#include "Optimizer.h"
+#include "ObjectiveFunction.h"
+#include "DE.h"
+#include "BlockRing.h"
+#include <memory>
+#include <vector>
+
+// 岛屿模型差分进化：种群分成 ISLANDS 个子种群，每个岛是一个独立的 DE，各自演化，岛之间没有逐代同步。
+// 每隔 MIGRATION_INTERVAL 代，每个岛把最好的 MIGRANTS 个个体发往拓扑上的邻岛，
+// 每条有向边是一个单生产者/单消费者的无锁队列（BlockRing），队列满时丢弃迁出个体；
+// 各岛每代取走所有已到达的个体，优于本岛最差个体时替换之。
+// 岛可以运行在线程池上，也可以各自运行在一个子进程中，此时队列放在进程间共享内存里。
+// 终止条件与进度回调在线程模式下每个迁移周期检查一次；进程模式下只支持代数与评估次数上限
+class IslandDE : public Optimizer {
+public:
+    enum Topology { Ring, BidirectionalRing, Complete };
+
+    // popSize 为所有岛的总个体数，平均分到各岛
+    IslandDE(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double F, double CR, double xmin, double xmax,
+             int islands, int migrationInterval, int migrants, Topology topology, bool processes);
+    virtual void run() override;
+    virtual const Individual& getBestIndividual() const override;
+    // 所有岛合在一起的多样性
+    virtual double getDiversity() const override;
+    virtual int copyPopulation(Scalar* X, Scalar* fitness, int capacity) const override;
+
+private:
+    const ObjectiveFunction& objFunc;
+    int DIM;
+    int MAX_GEN;
+    int ISLANDS;
+    int MIGRATION_INTERVAL;
+    int MIGRANTS;
+    Topology topology;
+    bool processes;
+
+    std::vector<std::unique_ptr<DE>> islands;
+    std::vector<int> islandSize;
+    // 有向边 e 从 edgeFrom[e] 指向 edgeTo[e]，outgoing/incoming 为各岛的边编号
+    std::vector<int> edgeFrom;
+    std::vector<int> edgeTo;
+    std::vector<std::vector<int>> outgoing;
+    std::vector<std::vector<int>> incoming;
+    std::vector<BlockRing> rings;
+    std::vector<std::vector<int>> order;   // 各岛挑选迁出个体用的下标
+    Individual best;
+    int bestIsland;                        // 线程模式下最优解所在的岛，为 -1 时最优解在 best 中
+
+    void buildTopology();
+    size_t ringBytes() const;
+    void createRings(char* memory);
+    // 推进第 begin ~ end-1 个岛的第 fromGen ~ toGen-1 代
+    void evolveIslands(int begin, int end, int fromGen, int toGen);
+    void emigrate(int island);
+    void immigrate(int island);
+    void runThreads();
+    void runProcesses();
+    void updateBest();
+};
+
+#endif // ISLAND_DE_H
@@ -0,0 +1,86 @@
+#include "MetropolisChain.h"
+#include <algorithm>
+#include <cmath>
+
+MetropolisChain::MetropolisChain(const ObjectiveFunction& objFunc, int dim, double xmin, double xmax, unsigned seed)
+    : objFunc(objFunc), separable(dynamic_cast<const SeparableObjective*>(&objFunc)), DIM(dim), X_MIN(xmin), X_MAX(xmax),
+      bestPending(false), stepsSinceSync(0), evaluations(0), gen(seed), dis(0.0, 1.0), dis_x(xmin, xmax)
+{
+    current.position.resize(DIM);
+    best.position.resize(DIM);
+    undoLog.reserve(DIM);
+}
+
+void MetropolisChain::initialize() {
+    for (int i = 0; i < DIM; ++i) {
+        current.position[i] = dis_x(gen);
+    }
+    current.fitness = objFunc.eval(current.position);
+    evaluations = 1;
+    best.fitness = current.fitness;
+    bestPending = true;
+    undoLog.clear();
+    stepsSinceSync = 0;
+}
+
+bool MetropolisChain::step(double temperature, Telemetry* telemetry) {
+    // 直接在当前解上修改一个坐标，不复制整个个体
+    int idx = gen() % DIM;
+    Scalar oldValue = current.position[idx];
+    current.position[idx] = dis_x(gen);
+    if (telemetry) telemetry->lap(Telemetry::Variation);
+    Scalar fitness;
+    if (separable && ++stepsSinceSync < DIM) {
+        fitness = separable->update(current.fitness, idx, oldValue, current.position[idx]);
+    } else {
+        // 增量更新每 DIM 步做一次完整评估，消除累积的舍入误差，均摊后仍是 O(1)
+        fitness = objFunc.eval(current.position);
+        stepsSinceSync = 0;
+    }
+    ++evaluations;
+    if (telemetry) telemetry->lap(Telemetry::Evaluation);
+
+    bool accept = fitnessLess(fitness, current.fitness) || dis(gen) < std::exp((current.fitness - fitness) / temperature);
+    if (accept) {
+        // 增量更新的值带有累积的舍入误差，可能低于真实的最小值（如球函数上得到负值）。
+        // 看起来是新的最优解时重新完整计算一次，同一个点不再计评估；只在改进时付出 O(D)
+        if (stepsSinceSync > 0 && fitnessLess(fitness, best.fitness)) {
+            fitness = objFunc.eval(current.position);
+            stepsSinceSync = 0;
+        }
+        current.fitness = fitness;
+        if (fitnessLess(current.fitness, best.fitness)) {
+            best.fitness = current.fitness;
+            bestPending = true;
+            undoLog.clear();
+        } else if (bestPending) {
+            undoLog.emplace_back(idx, oldValue);
+            if (static_cast<int>(undoLog.size()) >= DIM) materializeBest();
+        }
+    } else {
+        // 拒绝新解，恢复被修改的坐标
+        current.position[idx] = oldValue;
+    }
+    return accept;
+}
+
+void MetropolisChain::moveTo(const Scalar* position, Scalar fitness) {
+    materializeBest();
+    std::copy(position, position + DIM, current.position.begin());
+    current.fitness = fitness;
+    stepsSinceSync = 0;
+    if (fitnessLess(fitness, best.fitness)) {
+        best.fitness = fitness;
+        bestPending = true;
+    }
+}
+
+void MetropolisChain::materializeBest() {
+    if (!bestPending) return;
+    std::copy(current.position.begin(), current.position.end(), best.position.begin());
+    for (auto it = undoLog.rbegin(); it != undoLog.rend(); ++it) {
+        best.position[it->first] = it->second;
+    }
+    undoLog.clear();
+    bestPending = false;
+}
@@ -0,0 +1,52 @@
+#ifndef METROPOLIS_CHAIN_H
+#define METROPOLIS_CHAIN_H
+
+#include "Optimizer.h"
+#include "ObjectiveFunction.h"
+#include "SeparableObjective.h"
+#include <random>
+#include <vector>
+
+// 每步随机重采样一个坐标的 Metropolis 链，SA 与并行回火（PT）共用。
+// 当前解就地修改；可分离的目标函数每步 O(1) 增量更新；最优解延迟复制。
+// 一条链只能由一个线程使用，不同的链可以在不同线程上同时运行
+class MetropolisChain {
+public:
+    MetropolisChain(const ObjectiveFunction& objFunc, int dim, double xmin, double xmax, unsigned seed);
+
+    // 随机初始解，计一次评估
+    void initialize();
+    // 在温度 temperature 下走一步，返回是否接受。telemetry 非空时记录变异与评估阶段的时间
+    bool step(double temperature, Telemetry* telemetry = nullptr);
+
+    const Individual& getCurrent() const { return current; }
+    Scalar getBestFitness() const { return best.fitness; }
+    // 先调用 materializeBest() 才能保证位置是最新的
+    const Individual& getBest() const { return best; }
+    void materializeBest();
+    // 把当前解移到 position（适应度已知），不计评估
+    void moveTo(const Scalar* position, Scalar fitness);
+    long long getEvaluations() const { return evaluations; }
+
+private:
+    const ObjectiveFunction& objFunc;
+    const SeparableObjective* separable;   // 目标函数可分离时非空，此时每步只需 O(1) 更新
+    int DIM;
+    double X_MIN;
+    double X_MAX;
+
+    Individual current;
+    Individual best;
+    // 最优解的延迟复制：bestPending 为真时，最优解等于 current 依次撤销 undoLog 中的修改，
+    // 这样每步都不必复制整个个体；日志长度达到 DIM 时才真正复制一次
+    bool bestPending;
+    std::vector<std::pair<int, Scalar>> undoLog;
+    int stepsSinceSync;
+    long long evaluations;
+
+    std::mt19937 gen;
+    std::uniform_real_distribution<> dis;
+    std::uniform_real_distribution<> dis_x;
+};
+
+#endif // METROPOLIS_CHAIN_H
@@ -1,18 +1,22 @@
 #ifndef MICHALIEWICZ_FUNCTION_H
 #define MICHALIEWICZ_FUNCTION_H
 
-#include "ObjectiveFunction.h"
+#include "SeparableObjective.h"
 #include <cmath>
 
-class MichalewiczFunction : public ObjectiveFunction {
+class MichalewiczFunction : public SeparableObjective {
 public:
     MichalewiczFunction(int dim, int m = 10): dimension(dim), M(m) {}
-    virtual double eval(const std::vector<double>& x) const override {
-        double sum = 0.0;
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        Scalar sum = 0.0;
         for (int i = 0; i < dimension; ++i) {
-            sum += sin(x[i]) * std::pow(sin(((i + 1) * x[i] * x[i]) / M_PI), 2 * M);
+            sum += MichalewiczFunction::term(i, x[i]);
         }
-        return -sum;
+        return sum;
+    }
+    // 原函数为 -Σ sin(x_i) sin^{2M}((i+1) x_i^2 / π)，负号放进每一项
+    virtual Scalar term(int i, Scalar xi) const override {
+        return -std::sin(xi) * static_cast<Scalar>(std::pow(std::sin(((i + 1) * xi * xi) / static_cast<Scalar>(M_PI)), 2 * M));
     }
 
 private:
@@ -1,12 +1,33 @@
 #ifndef OBJECTIVE_FUNCTION_H
 #define OBJECTIVE_FUNCTION_H
 
+#include "Scalar.h"
+#include <cstddef>
 #include <vector>
 
 class ObjectiveFunction {
 public:
     virtual ~ObjectiveFunction() {}
-    virtual double eval(const std::vector<double>& x) const = 0;
+    virtual Scalar eval(const std::vector<Scalar>& x) const = 0;
+
+    // 批量评估 n 个连续存放的点，第 i 个点为 X[i*dim .. i*dim+dim)，结果写入 out[i]。
+    // 默认逐个复制到线程局部的缓冲区再调用 eval()，可以被多个线程同时调用
+    virtual void evalBatch(const Scalar* X, int n, int dim, Scalar* out) const {
+        thread_local std::vector<Scalar> x;
+        for (int i = 0; i < n; ++i) {
+            x.assign(X + static_cast<size_t>(i) * dim, X + static_cast<size_t>(i + 1) * dim);
+            out[i] = eval(x);
+        }
+    }
+
+    // 能否在 fork 出的子进程中继续使用（岛屿模型的进程模式）。子进程只有调用 fork 的线程，
+    // 持有外部资源（与父进程共用的管道）的目标函数返回 false；带锁的目标函数在 multithreaded
+    // 为 true（fork 时其他线程可能正持有锁）时返回 false
+    virtual bool forkSafe(bool /*multithreaded*/) const { return true; }
+
+    // evalBatch 成批评估明显比逐点调用 eval 便宜时返回 true（外部进程、其他语言的回调）。
+    // GA 与 DE 据此把一代的新个体攒成一批评估；内置函数仍逐点评估，省去复制
+    virtual bool prefersBatch() const { return false; }
 };
 
 #endif // OBJECTIVE_FUNCTION_H
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "Optimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void Optimizer::addTermination(std::unique_ptr<TerminationCriterion> criterion) {
+    needsDiversity = needsDiversity || criterion->needsDiversity();
+    criteria.push_back(std::move(criterion));
+}
+
+void Optimizer::setProgressCallback(ProgressCallback callback, int interval) {
+    this->callback = std::move(callback);
+    callbackInterval = interval > 0 ? interval : 1;
+}
+
+std::string Optimizer::getStopReason() const {
+    if (stopReason) return stopReason;
+    return evaluationBudgetExhausted() ? "max_evals" : "";
+}
+
+double Optimizer::getDiversity() const {
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+int Optimizer::copyPopulation(Scalar* X, Scalar* fitness, int capacity) const {
+    const Individual& best = getBestIndividual();
+    if (capacity > 0) {
+        std::copy(best.position.begin(), best.position.end(), X);
+        fitness[0] = best.fitness;
+    }
+    return 1;
+}
+
+int Optimizer::copyRows(const std::vector<Individual>& rows, int count, Scalar* X, Scalar* fitness, int capacity) {
+    int n = std::min(count, capacity);
+    for (int i = 0; i < n; ++i) {
+        std::copy(rows[i].position.begin(), rows[i].position.end(), X + i * rows[i].position.size());
+        fitness[i] = rows[i].fitness;
+    }
+    return count;
+}
+
+void Optimizer::startProgress() {
+    stopReason = nullptr;
+    checks = 0;
+    for (auto& criterion : criteria) criterion->reset();
+    runStart = std::chrono::steady_clock::now();
+}
+
+bool Optimizer::evaluateProgress(int generation) {
+    Progress progress;
+    progress.generation = generation;
+    progress.evaluations = evaluations;
+    progress.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    progress.best = &getBestIndividual();
+    progress.diversity = needsDiversity ? getDiversity() : std::numeric_limits<double>::quiet_NaN();
+    if (callback && checks++ % callbackInterval == 0) callback(progress);
+    for (auto& criterion : criteria) {
+        if (criterion->done(progress)) {
+            stopReason = criterion->name();
+            return true;
+        }
+    }
+    return false;
+}
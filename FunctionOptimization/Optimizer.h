@@ -1,14 +1,20 @@
 #ifndef OPTIMIZER_H
 #define OPTIMIZER_H
 
-#include <vector>
-#ifdef ENABLE_DATA_COLLECTION
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <string>
-#endif
+#include <vector>
+#include "Scalar.h"
+#include "Telemetry.h"
+#include "Termination.h"
+
+class ThreadPool;
 
 struct Individual {
-    std::vector<double> position;
-    double fitness;
+    std::vector<Scalar> position;
+    Scalar fitness;
 };
 
 class Optimizer {
@@ -16,23 +22,67 @@ public:
     virtual ~Optimizer() {}
     virtual void run() = 0;
     virtual const Individual& getBestIndividual() const = 0;
-#ifdef ENABLE_DATA_COLLECTION
-    virtual const std::vector<std::string> getDataBuffer() const { 
-        std::string header = "Generation,Individual";
-        for (size_t d = 1; d <= getBestIndividual().position.size(); ++d) {
-            header += ",x" + std::to_string(d);
-        }
-        header += ",Fitness";
-        std::vector<std::string> modifiedDataBuffer({ header });
-        modifiedDataBuffer.insert(modifiedDataBuffer.end(), dataBuffer.begin(), dataBuffer.end());
-        return modifiedDataBuffer;
-    }
-    virtual void clearDataBuffer() { dataBuffer.clear(); }
-#endif
+
+    // 本次运行中目标函数的评估次数
+    long long getEvaluationCount() const { return evaluations; }
+    // 评估次数上限，0 表示不限。各算法每代（SA 每步，PT 每轮交换）检查一次，
+    // 因此实际的评估次数最多超出一代的评估次数；达到上限后 run() 提前返回
+    void setMaxEvaluations(long long limit) { maxEvaluations = limit; }
+    long long getMaxEvaluations() const { return maxEvaluations; }
+    bool evaluationBudgetExhausted() const { return maxEvaluations > 0 && evaluations >= maxEvaluations; }
+    // 遥测默认关闭，可在运行前通过 getTelemetry().setEnabled(true) 打开
+    Telemetry& getTelemetry() { return telemetry; }
+    const Telemetry& getTelemetry() const { return telemetry; }
+    // 可以在一次运行内部并行的算法使用该线程池，为空时串行执行
+    void setThreadPool(ThreadPool* pool) { this->pool = pool; }
+
+    // 终止条件与进度回调，每代结束时检查（SA 每 D 步一次）。都没有设置时只剩一次分支判断
+    void addTermination(std::unique_ptr<TerminationCriterion> criterion);
+    void clearTermination() { criteria.clear(); }
+    // 每 interval 次检查调用一次 callback，Progress 中的最优解指向算法内部的数据，不复制
+    typedef std::function<void(const Progress&)> ProgressCallback;
+    void setProgressCallback(ProgressCallback callback, int interval = 1);
+    // 上一次 run() 提前结束的原因：终止条件的名称，或 "max_evals"；运行满 max_gen 时为空
+    std::string getStopReason() const;
+    // 当前种群的多样性（个体到中心的均方根距离），没有种群的算法返回 NaN
+    virtual double getDiversity() const;
+    // 把当前种群按行复制到 X（每行 D 个坐标）与 fitness，最多 capacity 行，返回种群大小；capacity 为 0 时只返回大小。
+    // 在进度回调中调用可以得到每代的种群。没有种群的算法默认只给出最优解一行，PT 给出各级温度上的当前解
+    virtual int copyPopulation(Scalar* X, Scalar* fitness, int capacity) const;
+
+    // 逐代推进的接口，供岛屿模型与算法组合（Portfolio）从外部驱动一次运行：initialize() 后反复调用 step()，最后 finish()。
+    // 每次 step() 之后 getBestIndividual() 即是当前最优解。SA、GA、PSO、DE 支持，其余算法 steppable() 为 false
+    virtual bool steppable() const { return false; }
+    virtual void initialize() {}
+    virtual void step(int /*generation*/) {}
+    virtual void finish() {}
+    // 接收外部的个体（迁移或其他算法找到的好解），默认忽略
+    virtual void immigrate(const Scalar* /*position*/, Scalar /*fitness*/) {}
+
 protected:
-#ifdef ENABLE_DATA_COLLECTION
-    std::vector<std::string> dataBuffer;
-#endif
+    long long evaluations = 0;
+    long long maxEvaluations = 0;
+
+    // 由各算法在 run() 开始时调用
+    void startProgress();
+    bool progressActive() const { return !criteria.empty() || static_cast<bool>(callback); }
+    // 第 generation 代结束时调用，此时 getBestIndividual() 须是当前最优解。返回 true 表示应当停止
+    bool checkProgress(int generation) { return progressActive() && evaluateProgress(generation); }
+    // copyPopulation 的公共部分：复制 rows 的前 count 个个体
+    static int copyRows(const std::vector<Individual>& rows, int count, Scalar* X, Scalar* fitness, int capacity);
+    Telemetry telemetry;
+    ThreadPool* pool = nullptr;
+
+private:
+    std::vector<std::unique_ptr<TerminationCriterion>> criteria;
+    ProgressCallback callback;
+    int callbackInterval = 1;
+    int checks = 0;
+    bool needsDiversity = false;
+    const char* stopReason = nullptr;
+    std::chrono::steady_clock::time_point runStart;
+
+    bool evaluateProgress(int generation);
 };
 
-#endif // OPTIMIZER_H
\ No newline at end of file
+#endif // OPTIMIZER_H
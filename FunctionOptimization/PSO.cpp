@@ -1,83 +1,284 @@
 #include "PSO.h"
+#include "ThreadPool.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
-PSO::PSO(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax, double w, double c1, double c2)
+PSO::PSO(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax, double w, double c1, double c2,
+         bool synchronous, Topology topology, int neighbors)
     : objFunc(objFunc), DIM(dim), POP_SIZE(popSize), MAX_GEN(maxGen), X_MIN(xmin), X_MAX(xmax), w(w), c1(c1), c2(c2),
-      gen(rd()), dis(0.0, 1.0)
+      synchronous(synchronous), topology(topology), K(neighbors), gen(rd()), dis(0.0, 1.0), chunks(1)
 {
-    swarm.resize(POP_SIZE);
-    globalBest.bestFitness = std::numeric_limits<double>::infinity();
-#ifdef ENABLE_DATA_COLLECTION
-    // 写入表头
-    std::string header = "Generation,Individual";
-    for (int d = 1; d <= DIM; ++d) {
-        header += ",x" + std::to_string(d);
+    // 粒子、邻域与全局最优的缓冲区在构造时一次分配好
+    size_t size = static_cast<size_t>(POP_SIZE) * DIM;
+    positions.resize(size);
+    velocities.resize(size);
+    bestPositions.resize(size);
+    fitness.resize(POP_SIZE);
+    bestFitness.resize(POP_SIZE);
+    neighborStart.resize(POP_SIZE + 1);
+    neighborList.reserve(static_cast<size_t>(POP_SIZE) * (std::max(K, 4) + 1));
+    neighborhoodBest.resize(POP_SIZE);
+    globalBest.position.resize(DIM);
+    globalBest.fitness = std::numeric_limits<Scalar>::infinity();
+    randomBuffer.resize(2 * DIM);
+    if (topology == RandomK) {
+        randomLinks.resize(static_cast<size_t>(POP_SIZE) * K);
+        linkCount.resize(POP_SIZE);
     }
-    header += ",Fitness";
-    dataBuffer.push_back(header);
-#endif
+    buildTopology();
 }
 
 void PSO::initializeSwarm() {
+    evaluations = 0;
     std::uniform_real_distribution<> dis_x(X_MIN, X_MAX);
-    for (auto& p : swarm) {
-        p.position.resize(DIM);
-        p.velocity.resize(DIM, 0.0);
-        for (int i = 0; i < DIM; ++i) {
-            p.position[i] = dis_x(gen);
-        }
-        p.fitness = objFunc.eval(p.position);
-        p.bestPosition = p.position;
-        p.bestFitness = p.fitness;
+    std::fill(velocities.begin(), velocities.end(), Scalar(0));
+    for (auto& xi : positions) {
+        xi = dis_x(gen);
+    }
+    objFunc.evalBatch(positions.data(), POP_SIZE, DIM, fitness.data());
+    evaluations += POP_SIZE;
+    std::copy(positions.begin(), positions.end(), bestPositions.begin());
+    std::copy(fitness.begin(), fitness.end(), bestFitness.begin());
+
+    bestIndex = static_cast<int>(std::min_element(bestFitness.begin(), bestFitness.end(), fitnessLess) - bestFitness.begin());
+    std::copy(&bestPositions[bestIndex * DIM], &bestPositions[bestIndex * DIM] + DIM, globalBest.position.begin());
+    globalBest.fitness = bestFitness[bestIndex];
+    improved = true;
+    if (topology == RandomK) buildTopology();
+}
 
-        if (p.fitness < globalBest.bestFitness) {
-            globalBest = p;
+void PSO::buildTopology() {
+    neighborList.clear();
+    if (topology == Global) {
+        // 全局拓扑直接使用 bestIndex，不需要邻居表
+        std::fill(neighborStart.begin(), neighborStart.end(), 0);
+        return;
+    }
+    if (topology == Ring) {
+        for (int i = 0; i < POP_SIZE; ++i) {
+            neighborStart[i] = static_cast<int>(neighborList.size());
+            neighborList.push_back(i);
+            if (POP_SIZE > 1) neighborList.push_back((i + POP_SIZE - 1) % POP_SIZE);
+            if (POP_SIZE > 2) neighborList.push_back((i + 1) % POP_SIZE);
+        }
+    } else if (topology == VonNeumann) {
+        // 粒子排成 rows×cols 的环面网格，最后一行可能不满，不存在的位置跳过
+        int cols = std::max(1, static_cast<int>(std::lround(std::sqrt(static_cast<double>(POP_SIZE)))));
+        int rows = (POP_SIZE + cols - 1) / cols;
+        for (int i = 0; i < POP_SIZE; ++i) {
+            neighborStart[i] = static_cast<int>(neighborList.size());
+            neighborList.push_back(i);
+            int r = i / cols, c = i % cols;
+            int candidates[4] = {
+                ((r + rows - 1) % rows) * cols + c, ((r + 1) % rows) * cols + c,
+                r * cols + (c + cols - 1) % cols, r * cols + (c + 1) % cols,
+            };
+            for (int j : candidates) {
+                if (j < POP_SIZE && std::find(neighborList.begin() + neighborStart[i], neighborList.end(), j) == neighborList.end()) {
+                    neighborList.push_back(j);
+                }
+            }
+        }
+    } else {
+        // 每个粒子通知自己和 K 个随机粒子，粒子的邻域是所有通知它的粒子。
+        // 先统计每个粒子被通知的次数得到各段起点，再把通知者填入各段
+        std::uniform_int_distribution<> pick(0, POP_SIZE - 1);
+        std::fill(linkCount.begin(), linkCount.end(), 1);
+        for (auto& t : randomLinks) {
+            t = pick(gen);
+            ++linkCount[t];
+        }
+        neighborStart[0] = 0;
+        for (int i = 0; i < POP_SIZE; ++i) {
+            neighborStart[i + 1] = neighborStart[i] + linkCount[i];
+            linkCount[i] = neighborStart[i];
+        }
+        neighborList.resize(neighborStart[POP_SIZE]);
+        for (int i = 0; i < POP_SIZE; ++i) neighborList[linkCount[i]++] = i;
+        for (size_t j = 0; j < randomLinks.size(); ++j) {
+            neighborList[linkCount[randomLinks[j]]++] = static_cast<int>(j / K);
         }
+        return;
+    }
+    neighborStart[POP_SIZE] = static_cast<int>(neighborList.size());
+}
+
+int PSO::bestNeighbor(int i) const {
+    if (topology == Global) return bestIndex;
+    int best = i;
+    for (int k = neighborStart[i]; k < neighborStart[i + 1]; ++k) {
+        int j = neighborList[k];
+        if (fitnessLess(bestFitness[j], bestFitness[best])) best = j;
+    }
+    return best;
+}
+
+void PSO::moveParticle(int i, int guide, std::mt19937& g, Scalar* r) {
+    std::uniform_real_distribution<> u(0.0, 1.0);
+    for (int d = 0; d < 2 * DIM; ++d) {
+        r[d] = u(g);
+    }
+    // 随机数预先生成，下面的循环只有乘加和比较，可以被编译器向量化。
+    // 系数先转换为 Scalar，单精度时整个循环都按 float 计算，不会逐个提升为 double
+    const Scalar* r1 = r;
+    const Scalar* r2 = r + DIM;
+    Scalar* x = &positions[static_cast<size_t>(i) * DIM];
+    Scalar* v = &velocities[static_cast<size_t>(i) * DIM];
+    const Scalar* p = &bestPositions[static_cast<size_t>(i) * DIM];
+    const Scalar* n = &bestPositions[static_cast<size_t>(guide) * DIM];
+    const Scalar sw = static_cast<Scalar>(w), sc1 = static_cast<Scalar>(c1), sc2 = static_cast<Scalar>(c2);
+    const Scalar lo = static_cast<Scalar>(X_MIN), hi = static_cast<Scalar>(X_MAX);
+    for (int d = 0; d < DIM; ++d) {
+        Scalar vd = sw * v[d] + sc1 * r1[d] * (p[d] - x[d]) + sc2 * r2[d] * (n[d] - x[d]);
+        Scalar xd = x[d] + vd;
+        xd = xd < lo ? lo : xd;
+        xd = xd > hi ? hi : xd;
+        v[d] = vd;
+        x[d] = xd;
+    }
+}
+
+void PSO::updateBest(int i) {
+    if (fitnessLess(fitness[i], bestFitness[i])) {
+        bestFitness[i] = fitness[i];
+        std::copy(&positions[static_cast<size_t>(i) * DIM], &positions[static_cast<size_t>(i) * DIM] + DIM,
+                  &bestPositions[static_cast<size_t>(i) * DIM]);
     }
 }
 
 void PSO::updateVelocityAndPosition() {
-    for (auto& p : swarm) {
-        for (int i = 0; i < DIM; ++i) {
-            double r1 = dis(gen);
-            double r2 = dis(gen);
-            p.velocity[i] = w * p.velocity[i] + c1 * r1 * (p.bestPosition[i] - p.position[i]) + c2 * r2 * (globalBest.position[i] - p.position[i]);
-            p.position[i] += p.velocity[i];
-            if (p.position[i] < X_MIN) p.position[i] = X_MIN;
-            if (p.position[i] > X_MAX) p.position[i] = X_MAX;
+    telemetry.startPhases();
+    // 与同步版本相同：上一次迭代全局最优没有改进时重新抽取随机 k 拓扑的连接
+    if (topology == RandomK && !improved) buildTopology();
+    improved = false;
+    for (int i = 0; i < POP_SIZE; ++i) {
+        moveParticle(i, bestNeighbor(i), gen, randomBuffer.data());
+        telemetry.lap(Telemetry::Variation);
+        objFunc.evalBatch(&positions[static_cast<size_t>(i) * DIM], 1, DIM, &fitness[i]);
+        ++evaluations;
+        telemetry.lap(Telemetry::Evaluation);
+        updateBest(i);
+        if (fitnessLess(bestFitness[i], globalBest.fitness)) {
+            improved = true;
+            bestIndex = i;
+            std::copy(&positions[static_cast<size_t>(i) * DIM], &positions[static_cast<size_t>(i) * DIM] + DIM,
+                      globalBest.position.begin());
+            globalBest.fitness = bestFitness[i];
         }
-        p.fitness = objFunc.eval(p.position);
-        if (p.fitness < p.bestFitness) {
-            p.bestFitness = p.fitness;
-            p.bestPosition = p.position;
+        telemetry.lap(Telemetry::Selection);
+    }
+}
+
+void PSO::updateSynchronous(int chunks) {
+    // 串行时直接调用，并行时在线程池上按粒子分段执行
+    auto sweep = [&](const std::function<void(int, int, int)>& body) {
+        if (chunks > 1) pool->parallelFor(POP_SIZE, chunks, body);
+        else body(0, 0, POP_SIZE);
+    };
+
+    telemetry.startPhases();
+    if (topology == RandomK && !improved) buildTopology();
+    for (int i = 0; i < POP_SIZE; ++i) {
+        neighborhoodBest[i] = bestNeighbor(i);
+    }
+    telemetry.lap(Telemetry::Selection);
+
+    // 各阶段只写自己分段内的粒子，读取的个体最优在本阶段内不变，不需要加锁
+    sweep([this](int c, int begin, int end) {
+        Scalar* r = &randomBuffer[static_cast<size_t>(c) * 2 * DIM];
+        for (int i = begin; i < end; ++i) {
+            moveParticle(i, neighborhoodBest[i], chunkGen[c], r);
         }
-        if (p.fitness < globalBest.bestFitness) {
-            globalBest = p;
+    });
+    telemetry.lap(Telemetry::Variation);
+
+    sweep([this](int, int begin, int end) {
+        objFunc.evalBatch(&positions[static_cast<size_t>(begin) * DIM], end - begin, DIM, &fitness[begin]);
+    });
+    evaluations += POP_SIZE;
+    telemetry.lap(Telemetry::Evaluation);
+
+    sweep([this](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) updateBest(i);
+    });
+    int best = static_cast<int>(std::min_element(bestFitness.begin(), bestFitness.end(), fitnessLess) - bestFitness.begin());
+    improved = fitnessLess(bestFitness[best], globalBest.fitness);
+    if (improved) {
+        bestIndex = best;
+        std::copy(&bestPositions[static_cast<size_t>(best) * DIM], &bestPositions[static_cast<size_t>(best) * DIM] + DIM,
+                  globalBest.position.begin());
+        globalBest.fitness = bestFitness[best];
+    }
+    telemetry.lap(Telemetry::Selection);
+}
+
+void PSO::recordGeneration(int generation) {
+    if (!telemetry.isEnabled()) return;
+    telemetry.beginGeneration(generation, evaluations);
+    for (int i = 0; i < POP_SIZE; ++i) {
+        telemetry.addRow(i, &positions[static_cast<size_t>(i) * DIM], fitness[i]);
+    }
+    telemetry.endGeneration();
+}
+
+void PSO::initialize() {
+    chunks = 1;
+    if (synchronous) {
+        // 每个线程一个分段，分段数变化时才重新分配随机数发生器
+        chunks = pool ? std::max(1, std::min(pool->size(), POP_SIZE)) : 1;
+        if (static_cast<int>(chunkGen.size()) != chunks) {
+            chunkGen.clear();
+            for (int c = 0; c < chunks; ++c) chunkGen.emplace_back(gen());
+            randomBuffer.resize(static_cast<size_t>(chunks) * 2 * DIM);
         }
     }
+    initializeSwarm();
+    startProgress();
+    telemetry.beginRun(DIM, POP_SIZE, MAX_GEN);
+}
+
+void PSO::step(int generation) {
+    if (synchronous) updateSynchronous(chunks);
+    else updateVelocityAndPosition();
+    recordGeneration(generation);
+}
+
+void PSO::immigrate(const Scalar* position, Scalar fitness) {
+    int worst = static_cast<int>(std::max_element(bestFitness.begin(), bestFitness.end(), fitnessLess) - bestFitness.begin());
+    if (!fitnessLess(fitness, bestFitness[worst])) return;
+    size_t offset = static_cast<size_t>(worst) * DIM;
+    std::copy(position, position + DIM, &positions[offset]);
+    std::copy(position, position + DIM, &bestPositions[offset]);
+    this->fitness[worst] = fitness;
+    bestFitness[worst] = fitness;
+    if (fitnessLess(fitness, globalBest.fitness)) {
+        bestIndex = worst;
+        std::copy(position, position + DIM, globalBest.position.begin());
+        globalBest.fitness = fitness;
+    }
 }
 
 void PSO::run() {
-    initializeSwarm();
-    for (int generation = 0; generation < MAX_GEN; ++generation) {
-        updateVelocityAndPosition();
-#ifdef ENABLE_DATA_COLLECTION
-        for (int i = 0; i < POP_SIZE; ++i) {
-            std::string line = std::to_string(generation) + "," + std::to_string(i);
-            for (const auto& xi : swarm[i].position) {
-                line += "," + std::to_string(xi);
-            }
-            line += "," + std::to_string(swarm[i].fitness);
-            dataBuffer.push_back(line);
-        }
-#endif
+    initialize();
+    for (int generation = 0; generation < MAX_GEN && !evaluationBudgetExhausted(); ++generation) {
+        step(generation);
+        if (checkProgress(generation)) break;
     }
+    finish();
+}
+
+double PSO::getDiversity() const {
+    return populationDiversity(positions.data(), POP_SIZE, DIM);
+}
+
+int PSO::copyPopulation(Scalar* X, Scalar* fitness, int capacity) const {
+    int n = std::min(POP_SIZE, capacity);
+    std::copy(positions.begin(), positions.begin() + static_cast<size_t>(n) * DIM, X);
+    std::copy(this->fitness.begin(), this->fitness.begin() + n, fitness);
+    return POP_SIZE;
 }
 
 const Individual& PSO::getBestIndividual() const {
-    static Individual ind; 
-    ind.position = globalBest.position;
-    ind.fitness = globalBest.bestFitness;
-    return ind;
-}
\ No newline at end of file
+    return globalBest;
+}
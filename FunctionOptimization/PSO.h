@@ -6,19 +6,29 @@
 #include <vector>
 #include <random>
 
-struct Particle {
-    std::vector<double> position;
-    std::vector<double> velocity;
-    double fitness;
-    std::vector<double> bestPosition;
-    double bestFitness;
-};
-
 class PSO : public Optimizer {
 public:
-    PSO(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax, double w, double c1, double c2);
+    // 邻域拓扑：全局、环形（左右各一个）、冯·诺依曼网格（上下左右）、
+    // 随机 k（每个粒子随机通知 k 个粒子，全局最优没有改进时重新生成，同 SPSO 2011）
+    enum Topology { Global, Ring, VonNeumann, RandomK };
+
+    // synchronous 为 false 时每个粒子更新后立即更新邻域最优（原来的异步方式）；
+    // 为 true 时每次迭代先按上一次迭代的个体最优确定邻域最优，再整体更新所有粒子，
+    // 各阶段在线程池上按粒子分段并行
+    PSO(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax, double w, double c1, double c2,
+        bool synchronous = false, Topology topology = Global, int neighbors = 3);
     virtual void run() override;
     virtual const Individual& getBestIndividual() const override;
+    virtual double getDiversity() const override;
+    virtual int copyPopulation(Scalar* X, Scalar* fitness, int capacity) const override;
+
+    // run() 即 initialize + MAX_GEN 次 step + finish
+    virtual bool steppable() const override { return true; }
+    virtual void initialize() override;
+    virtual void step(int generation) override;
+    virtual void finish() override { telemetry.endRun(); }
+    // 迁入个体优于个体最优最差的粒子时，该粒子移到迁入位置，速度不变
+    virtual void immigrate(const Scalar* position, Scalar fitness) override;
 
 private:
     const ObjectiveFunction& objFunc;
@@ -28,16 +38,44 @@ private:
     double X_MIN;
     double X_MAX;
     double w, c1, c2;
+    bool synchronous;
+    Topology topology;
+    int K;
+
+    // 粒子数据按粒子连续存放，第 i 个粒子占 [i*DIM, i*DIM+DIM)
+    std::vector<Scalar> positions;
+    std::vector<Scalar> velocities;
+    std::vector<Scalar> bestPositions;
+    std::vector<Scalar> fitness;
+    std::vector<Scalar> bestFitness;
 
-    std::vector<Particle> swarm;
-    Particle globalBest;
+    // 邻域（含自身）：粒子 i 的邻居为 neighborList[neighborStart[i] .. neighborStart[i+1])
+    std::vector<int> neighborStart;
+    std::vector<int> neighborList;
+    std::vector<int> neighborhoodBest;   // 同步模式下本次迭代各粒子的邻域最优
+    std::vector<int> randomLinks;        // 随机 k 拓扑：粒子 j/K 通知的粒子
+    std::vector<int> linkCount;
+    int bestIndex;                       // 个体最优中最好的粒子
+    bool improved;                       // 上一次迭代全局最优是否有改进
+    // 只保存全局最优的位置与适应度，更新时复制到已分配好的缓冲区
+    Individual globalBest;
 
     std::random_device rd;
     std::mt19937 gen;
     std::uniform_real_distribution<> dis;
+    // 同步模式每个分段一个随机数发生器和一段随机数缓冲区（每个粒子 2*DIM 个）
+    std::vector<std::mt19937> chunkGen;
+    std::vector<Scalar> randomBuffer;
+    int chunks;                          // 同步模式本次运行的分段数
 
     void initializeSwarm();
+    void buildTopology();
+    int bestNeighbor(int i) const;
+    void moveParticle(int i, int guide, std::mt19937& g, Scalar* r);
+    void updateBest(int i);
     void updateVelocityAndPosition();
+    void updateSynchronous(int chunks);
+    void recordGeneration(int generation);
 };
 
-#endif // PSO_H
\ No newline at end of file
+#endif // PSO_H
@@ -0,0 +1,159 @@
+#include "PT.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 每隔多少轮交换调整一次温度阶梯，以及初始的调整幅度（随调整次数按 1/sqrt(n) 衰减）
+const int ADAPT_ROUNDS = 10;
+const double ADAPT_RATE = 0.5;
+}
+
+PT::PT(const ObjectiveFunction& objFunc, int dim, int maxGen, double xmin, double xmax, int replicas,
+       double minTemp, double maxTemp, int exchangeInterval, bool adaptive)
+    : DIM(dim), MAX_GEN(maxGen), REPLICAS(std::max(1, replicas)), minTemp(minTemp), maxTemp(maxTemp),
+      EXCHANGE_INTERVAL(std::max(1, exchangeInterval)), adaptive(adaptive), gen(rd()), dis(0.0, 1.0), adaptations(0), bestChain(0)
+{
+    for (int r = 0; r < REPLICAS; ++r) {
+        chains.emplace_back(new MetropolisChain(objFunc, dim, xmin, xmax, rd()));
+    }
+    temperatures.resize(REPLICAS);
+    chainAt.resize(REPLICAS);
+    chainTemperature.resize(REPLICAS);
+    swapAttempts.resize(REPLICAS);
+    swapAccepts.resize(REPLICAS);
+    logGaps.resize(REPLICAS);
+}
+
+void PT::initializeLadder() {
+    // 初始为几何阶梯，即对数温度等间隔
+    for (int k = 0; k < REPLICAS; ++k) {
+        temperatures[k] = REPLICAS > 1 ? minTemp * std::pow(maxTemp / minTemp, static_cast<double>(k) / (REPLICAS - 1)) : minTemp;
+        chainAt[k] = k;
+        chainTemperature[k] = temperatures[k];
+        logGaps[k] = k + 1 < REPLICAS ? std::log(maxTemp / minTemp) / (REPLICAS - 1) : 0.0;
+    }
+    std::fill(swapAttempts.begin(), swapAttempts.end(), 0);
+    std::fill(swapAccepts.begin(), swapAccepts.end(), 0);
+    adaptations = 0;
+}
+
+void PT::exchange(int round) {
+    // 奇偶轮交替尝试 (0,1),(2,3),... 与 (1,2),(3,4),...，每对只涉及两条链
+    for (int k = round % 2; k + 1 < REPLICAS; k += 2) {
+        int a = chainAt[k];
+        int b = chainAt[k + 1];
+        double delta = (1.0 / temperatures[k] - 1.0 / temperatures[k + 1])
+                       * (chains[a]->getCurrent().fitness - chains[b]->getCurrent().fitness);
+        ++swapAttempts[k];
+        if (delta >= 0 || dis(gen) < std::exp(delta)) {
+            ++swapAccepts[k];
+            std::swap(chainAt[k], chainAt[k + 1]);
+            chainTemperature[chainAt[k]] = temperatures[k];
+            chainTemperature[chainAt[k + 1]] = temperatures[k + 1];
+        }
+    }
+}
+
+void PT::adaptLadder() {
+    // 接受率高说明两级温度过近，加大间隔；接受率低则缩小间隔
+    int pairs = REPLICAS - 1;
+    double mean = 0.0;
+    for (int k = 0; k < pairs; ++k) {
+        mean += swapAttempts[k] > 0 ? static_cast<double>(swapAccepts[k]) / swapAttempts[k] : 0.0;
+    }
+    mean /= pairs;
+    double rate = ADAPT_RATE / std::sqrt(1.0 + adaptations++);
+    double total = 0.0;
+    for (int k = 0; k < pairs; ++k) {
+        double acceptance = swapAttempts[k] > 0 ? static_cast<double>(swapAccepts[k]) / swapAttempts[k] : 0.0;
+        logGaps[k] *= std::exp(rate * (acceptance - mean));
+        total += logGaps[k];
+        swapAttempts[k] = 0;
+        swapAccepts[k] = 0;
+    }
+    // 归一化使最高温度保持不变
+    double scale = std::log(maxTemp / minTemp) / total;
+    double logT = std::log(minTemp);
+    for (int k = 0; k < REPLICAS; ++k) {
+        temperatures[k] = std::exp(logT);
+        chainTemperature[chainAt[k]] = temperatures[k];
+        if (k < pairs) {
+            logGaps[k] *= scale;
+            logT += logGaps[k];
+        }
+    }
+    temperatures[REPLICAS - 1] = maxTemp;
+    chainTemperature[chainAt[REPLICAS - 1]] = maxTemp;
+}
+
+void PT::run() {
+    initializeLadder();
+    for (auto& chain : chains) chain->initialize();
+    evaluations = REPLICAS;
+    startProgress();
+    int rounds = (MAX_GEN + EXCHANGE_INTERVAL - 1) / EXCHANGE_INTERVAL;
+    int chunks = pool ? std::min(pool->size(), REPLICAS) : 1;
+    // 遥测以一轮交换为一代，每行是一级温度上的当前解（从低到高）
+    telemetry.beginRun(DIM, REPLICAS, rounds);
+
+    for (int round = 0; round < rounds && !evaluationBudgetExhausted(); ++round) {
+        telemetry.startPhases();
+        int steps = std::min(EXCHANGE_INTERVAL, MAX_GEN - round * EXCHANGE_INTERVAL);
+        auto sweep = [this, steps](int, int begin, int end) {
+            for (int c = begin; c < end; ++c) {
+                MetropolisChain& chain = *chains[c];
+                double t = chainTemperature[c];
+                for (int s = 0; s < steps; ++s) chain.step(t);
+            }
+        };
+        if (chunks > 1) pool->parallelFor(REPLICAS, chunks, sweep);
+        else sweep(0, 0, REPLICAS);
+        // 各链内的变异与评估在工作线程上交错进行，整体计入评估阶段
+        telemetry.lap(Telemetry::Evaluation);
+
+        exchange(round);
+        if (adaptive && REPLICAS > 2 && (round + 1) % ADAPT_ROUNDS == 0) adaptLadder();
+        telemetry.lap(Telemetry::Selection);
+
+        evaluations = 0;
+        for (const auto& chain : chains) evaluations += chain->getEvaluations();
+        if (telemetry.isEnabled()) {
+            telemetry.beginGeneration(round, evaluations);
+            for (int k = 0; k < REPLICAS; ++k) {
+                const Individual& x = chains[chainAt[k]]->getCurrent();
+                telemetry.addRow(k, x.position.data(), x.fitness);
+            }
+            telemetry.endGeneration();
+        }
+        if (progressActive()) {
+            updateBest();
+            if (checkProgress(round)) break;
+        }
+    }
+
+    updateBest();
+    telemetry.endRun();
+}
+
+void PT::updateBest() {
+    bestChain = 0;
+    for (int c = 1; c < REPLICAS; ++c) {
+        if (fitnessLess(chains[c]->getBestFitness(), chains[bestChain]->getBestFitness())) bestChain = c;
+    }
+    chains[bestChain]->materializeBest();
+}
+
+int PT::copyPopulation(Scalar* X, Scalar* fitness, int capacity) const {
+    int n = std::min(REPLICAS, capacity);
+    for (int k = 0; k < n; ++k) {
+        const Individual& x = chains[chainAt[k]]->getCurrent();
+        std::copy(x.position.begin(), x.position.end(), X + static_cast<size_t>(k) * DIM);
+        fitness[k] = x.fitness;
+    }
+    return REPLICAS;
+}
+
+const Individual& PT::getBestIndividual() const {
+    return chains[bestChain]->getBest();
+}
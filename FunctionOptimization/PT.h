@@ -0,0 +1,57 @@
+#ifndef PT_H
+#define PT_H
+
+#include "Optimizer.h"
+#include "ObjectiveFunction.h"
+#include "MetropolisChain.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+// 并行回火（副本交换）：REPLICAS 条 Metropolis 链分别在一组从低到高的温度上运行，
+// 每走 EXCHANGE_INTERVAL 步同步一次，相邻温度上的链按 Metropolis 准则交换温度。
+// 各链之间没有共享数据，两次同步之间在线程池上并行运行；交换只改变温度到链的映射，不复制解。
+// 温度阶梯可自适应：按相邻两级交换的接受率调整对数温度间隔，使各级接受率趋于一致，两端温度不变
+class PT : public Optimizer {
+public:
+    // maxGen 为每条链走的步数
+    PT(const ObjectiveFunction& objFunc, int dim, int maxGen, double xmin, double xmax, int replicas,
+       double minTemp, double maxTemp, int exchangeInterval, bool adaptive);
+    virtual void run() override;
+    virtual const Individual& getBestIndividual() const override;
+    virtual int copyPopulation(Scalar* X, Scalar* fitness, int capacity) const override;
+
+    // 当前的温度阶梯，从低到高
+    const std::vector<double>& getTemperatures() const { return temperatures; }
+
+private:
+    int DIM;
+    int MAX_GEN;
+    int REPLICAS;
+    double minTemp;
+    double maxTemp;
+    int EXCHANGE_INTERVAL;
+    bool adaptive;
+
+    std::random_device rd;
+    std::mt19937 gen;
+    std::uniform_real_distribution<> dis;
+
+    std::vector<std::unique_ptr<MetropolisChain>> chains;
+    std::vector<double> temperatures;
+    std::vector<int> chainAt;               // 第 k 级温度上的链
+    std::vector<double> chainTemperature;   // 每条链当前的温度
+    // 相邻两级 (k, k+1) 自上次调整以来的交换尝试与接受次数
+    std::vector<int> swapAttempts;
+    std::vector<int> swapAccepts;
+    std::vector<double> logGaps;
+    int adaptations;
+    int bestChain;                           // 最优解所在的链，最优解不另外复制
+
+    void initializeLadder();
+    void exchange(int round);
+    void adaptLadder();
+    void updateBest();
+};
+
+#endif // PT_H
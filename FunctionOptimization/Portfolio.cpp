@@ -0,0 +1,131 @@
+#include "Portfolio.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+Portfolio::Portfolio(std::vector<std::unique_ptr<Optimizer>> members, std::vector<std::string> names, int dim,
+                     long long budget, int roundEvals, double minShare, double decay)
+    : members(std::move(members)), names(std::move(names)), DIM(dim), BUDGET(budget), ROUND_EVALS(std::max(1, roundEvals)),
+      DECAY(decay), bestMember(0)
+{
+    MEMBERS = static_cast<int>(this->members.size());
+    if (MEMBERS == 0) throw std::invalid_argument("a portfolio needs at least one algorithm");
+    for (const auto& member : this->members) {
+        if (!member->steppable()) throw std::invalid_argument("portfolio members must support stepping (SA, GA, PSO or DE)");
+    }
+    MIN_SHARE = std::min(std::max(0.0, minShare), 1.0 / MEMBERS);
+    shares.resize(MEMBERS);
+    scores.resize(MEMBERS);
+    credit.resize(MEMBERS);
+    generations.resize(MEMBERS);
+    roundStart.resize(MEMBERS);
+    stalled.resize(MEMBERS);
+}
+
+void Portfolio::advance(int member) {
+    Optimizer& m = *members[member];
+    while (credit[member] > 0) {
+        long long used = m.getEvaluationCount();
+        m.step(generations[member]++);
+        used = m.getEvaluationCount() - used;
+        credit[member] -= static_cast<double>(used);
+        if (used == 0) {
+            // 这一代没有产生新的评估，以后也不会再有，继续分配份额会使总评估次数永远达不到预算
+            stalled[member] = 1;
+            credit[member] = 0.0;
+            break;
+        }
+    }
+}
+
+void Portfolio::updateShares(double before) {
+    // 收益：单位评估次数使全局最优下降的量；本轮没有运行的算法保持原来的平均收益
+    std::vector<double> gain(MEMBERS, -1.0);
+    double maxGain = 0.0;
+    for (int k = 0; k < MEMBERS; ++k) {
+        long long used = members[k]->getEvaluationCount() - roundStart[k];
+        if (used <= 0) continue;
+        gain[k] = std::max(0.0, before - members[k]->getBestIndividual().fitness) / static_cast<double>(used);
+        maxGain = std::max(maxGain, gain[k]);
+    }
+    double total = 0.0;
+    for (int k = 0; k < MEMBERS; ++k) {
+        if (gain[k] >= 0.0) scores[k] = DECAY * scores[k] + (1.0 - DECAY) * (maxGain > 0.0 ? gain[k] / maxGain : 0.0);
+        total += scores[k];
+    }
+    for (int k = 0; k < MEMBERS; ++k) {
+        shares[k] = total > 0.0 ? MIN_SHARE + (1.0 - MEMBERS * MIN_SHARE) * scores[k] / total : 1.0 / MEMBERS;
+    }
+}
+
+void Portfolio::updateBest() {
+    evaluations = 0;
+    for (int k = 0; k < MEMBERS; ++k) {
+        evaluations += members[k]->getEvaluationCount();
+        if (fitnessLess(members[k]->getBestIndividual().fitness, members[bestMember]->getBestIndividual().fitness)) bestMember = k;
+    }
+}
+
+void Portfolio::run() {
+    long long budget = maxEvaluations > 0 ? std::min(BUDGET, maxEvaluations) : BUDGET;
+    int chunks = pool ? std::min(pool->size(), MEMBERS) : 1;
+    std::fill(shares.begin(), shares.end(), 1.0 / MEMBERS);
+    std::fill(scores.begin(), scores.end(), 1.0);
+    std::fill(credit.begin(), credit.end(), 0.0);
+    std::fill(generations.begin(), generations.end(), 0);
+    std::fill(stalled.begin(), stalled.end(), 0);
+    for (auto& member : members) member->setThreadPool(pool);
+
+    auto initialize = [this](int, int begin, int end) {
+        for (int k = begin; k < end; ++k) members[k]->initialize();
+    };
+    if (chunks > 1) pool->parallelFor(MEMBERS, chunks, initialize);
+    else initialize(0, 0, MEMBERS);
+    bestMember = 0;
+    updateBest();
+    startProgress();
+    // 遥测以一轮为一代，每行是一个算法的最优解
+    telemetry.beginRun(DIM, MEMBERS, static_cast<int>((budget + ROUND_EVALS - 1) / ROUND_EVALS));
+
+    auto body = [this](int, int begin, int end) {
+        for (int k = begin; k < end; ++k) advance(k);
+    };
+    for (int round = 0; evaluations < budget; ++round) {
+        Scalar before = members[bestMember]->getBestIndividual().fitness;
+        double roundEvals = static_cast<double>(std::min<long long>(ROUND_EVALS, budget - evaluations));
+        // 所有算法都停滞时提前结束
+        if (std::all_of(stalled.begin(), stalled.end(), [](char s) { return s != 0; })) break;
+        for (int k = 0; k < MEMBERS; ++k) {
+            if (!stalled[k]) credit[k] += shares[k] * roundEvals;
+            roundStart[k] = members[k]->getEvaluationCount();
+        }
+        if (chunks > 1) pool->parallelFor(MEMBERS, chunks, body);
+        else body(0, 0, MEMBERS);
+
+        updateShares(before);
+        updateBest();
+        const Individual& best = members[bestMember]->getBestIndividual();
+        if (fitnessLess(best.fitness, before)) {
+            for (int k = 0; k < MEMBERS; ++k) {
+                if (k != bestMember) members[k]->immigrate(best.position.data(), best.fitness);
+            }
+        }
+        if (telemetry.isEnabled()) {
+            telemetry.beginGeneration(round, evaluations);
+            for (int k = 0; k < MEMBERS; ++k) {
+                const Individual& b = members[k]->getBestIndividual();
+                telemetry.addRow(k, b.position.data(), b.fitness);
+            }
+            telemetry.endGeneration();
+        }
+        if (checkProgress(round)) break;
+    }
+    for (auto& member : members) member->finish();
+    // finish() 可能重新计算最优值（如 GA 在可分离目标函数上完整评估最终种群），重新确定最优的算法
+    updateBest();
+    telemetry.endRun();
+}
+
+const Individual& Portfolio::getBestIndividual() const {
+    return members[bestMember]->getBestIndividual();
+}
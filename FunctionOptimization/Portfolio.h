@@ -0,0 +1,51 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include "Optimizer.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// 算法组合：几个可逐代推进的算法（默认 SA、GA、PSO、DE）在同一个线程池上同时优化同一个目标函数。
+// 运行分成若干轮，每轮共 ROUND_EVALS 次评估按份额分给各算法，各算法在线程池上并行推进，直到用完自己的份额；
+// 一代的评估次数超过份额的算法先欠着，欠下的次数从后面几轮的份额中扣除。
+// 每轮结束后按多臂老虎机的方式重新分配份额：收益为本轮全局最优的下降量除以用掉的评估次数，
+// 除以本轮最大收益后按 DECAY 做指数平均，份额与平均收益成正比，但不低于 MIN_SHARE，以便继续试探落后的算法。
+// 全局最优改进后迁入其余算法，好的解可以成为其他算法的起点
+class Portfolio : public Optimizer {
+public:
+    // members 须都支持逐代推进；budget 为所有算法合计的评估次数
+    Portfolio(std::vector<std::unique_ptr<Optimizer>> members, std::vector<std::string> names, int dim,
+              long long budget, int roundEvals, double minShare, double decay);
+    virtual void run() override;
+    virtual const Individual& getBestIndividual() const override;
+
+    const std::vector<std::string>& getMemberNames() const { return names; }
+    const Optimizer& getMember(int k) const { return *members[k]; }
+    // 最近一次运行结束时各算法的份额
+    const std::vector<double>& getShares() const { return shares; }
+
+private:
+    std::vector<std::unique_ptr<Optimizer>> members;
+    std::vector<std::string> names;
+    int DIM;
+    int MEMBERS;
+    long long BUDGET;
+    int ROUND_EVALS;
+    double MIN_SHARE;
+    double DECAY;
+
+    std::vector<double> shares;
+    std::vector<double> scores;          // 各算法归一化收益的指数平均
+    std::vector<double> credit;          // 各算法尚可使用的评估次数，为负时表示欠下的次数
+    std::vector<int> generations;        // 各算法已推进的代数
+    std::vector<long long> roundStart;   // 各算法本轮开始时的评估次数
+    std::vector<char> stalled;           // 推进一代却没有用掉任何评估的算法（如不交叉也不变异的 GA），之后不再分配份额
+    int bestMember;
+
+    void advance(int member);
+    void updateShares(double before);
+    void updateBest();
+};
+
+#endif // PORTFOLIO_H
@@ -1,19 +1,24 @@
 #ifndef RASTRIGIN_FUNCTION_H
 #define RASTRIGIN_FUNCTION_H
 
-#include "ObjectiveFunction.h"
+#include "SeparableObjective.h"
 #include <cmath>
 
-class RastriginFunction : public ObjectiveFunction {
+class RastriginFunction : public SeparableObjective {
 public:
     RastriginFunction(int dim): dimension(dim) {}
-    virtual double eval(const std::vector<double>& x) const override {
-        double sum = 10 * dimension;
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        Scalar sum = 0;
         for (int i = 0; i < dimension; ++i) {
-            sum += x[i] * x[i] - 10 * cos(2 * M_PI * x[i]);
+            sum += RastriginFunction::term(i, x[i]);
         }
         return sum;
     }
+    // 10 - 10 cos(2πx) = 20 sin²(πx)，与原式相同，但最优解附近不会由两个接近 10 的数相减，单精度下仍能精确到 0
+    virtual Scalar term(int, Scalar xi) const override {
+        Scalar s = std::sin(static_cast<Scalar>(M_PI) * xi);
+        return xi * xi + 20 * s * s;
+    }
 
 private:
     int dimension;
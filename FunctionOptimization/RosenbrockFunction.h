@@ -0,0 +1,24 @@
+#ifndef ROSENBROCK_FUNCTION_H
+#define ROSENBROCK_FUNCTION_H
+
+#include "ObjectiveFunction.h"
+
+// 最优解在 (1, 1, ..., 1)
+class RosenbrockFunction : public ObjectiveFunction {
+public:
+    RosenbrockFunction(int dim): dimension(dim) {}
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        Scalar sum = 0;
+        for (int i = 0; i + 1 < dimension; ++i) {
+            Scalar a = x[i + 1] - x[i] * x[i];
+            Scalar b = 1 - x[i];
+            sum += 100 * a * a + b * b;
+        }
+        return sum;
+    }
+
+private:
+    int dimension;
+};
+
+#endif // ROSENBROCK_FUNCTION_H
@@ -3,7 +3,7 @@
 
 #include "Optimizer.h"
 #include "ObjectiveFunction.h"
-#include <vector>
+#include "MetropolisChain.h"
 #include <random>
 
 class SA : public Optimizer {
@@ -12,24 +12,26 @@ public:
     virtual void run() override;
     virtual const Individual& getBestIndividual() const override;
 
+    // 逐代推进时一次 step() 走 DIM 步；run() 的 MAX_GEN 仍是步数
+    virtual bool steppable() const override { return true; }
+    virtual void initialize() override;
+    virtual void step(int generation) override;
+    virtual void finish() override;
+    // 迁入个体优于当前解时，当前解移到该位置
+    virtual void immigrate(const Scalar* position, Scalar fitness) override;
+
 private:
-    const ObjectiveFunction& objFunc;
     int DIM;
     int MAX_GEN;
-    double X_MIN;
-    double X_MAX;
+    double initialTemp;
     double temp;
     double coolingRate;
 
-    Individual current;
-    Individual best;
     std::random_device rd;
-    std::mt19937 gen;
-    std::uniform_real_distribution<> dis;
+    MetropolisChain chain;
+    int steps;                  // 本次运行已走的步数
 
-    void initialize();
-    Individual neighbor(const Individual& ind);
-    double acceptanceProbability(double oldFitness, double newFitness, double temperature);
+    void metropolisStep(int step);
 };
 
-#endif // SA_H
\ No newline at end of file
+#endif // SA_H
@@ -0,0 +1,21 @@
+#ifndef SCALAR_H
+#define SCALAR_H
+
+#include <cmath>
+
+// 坐标与适应度的标量类型，默认为 double。用 make SCALAR=float 编译时定义 SCALAR_FLOAT，改为 float：
+// 向量化时每条指令处理的坐标数加倍，种群与旋转矩阵占用的内存和带宽减半。
+// 算法内部的策略参数（温度、步长、协方差矩阵等）与遥测统计量不受影响，仍为 double
+#ifdef SCALAR_FLOAT
+typedef float Scalar;
+#else
+typedef double Scalar;
+#endif
+
+// 适应度比较：a 优于 b。NaN（例如单精度下溢出为 inf 后增量评估得到 inf - inf）视为最差，
+// 不会因为与它比较的结果总是 false 而一直留在种群中或被当作最优解
+inline bool fitnessLess(Scalar a, Scalar b) {
+    return a < b || (std::isnan(b) && !std::isnan(a));
+}
+
+#endif // SCALAR_H
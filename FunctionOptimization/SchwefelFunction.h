@@ -0,0 +1,45 @@
+#ifndef SCHWEFEL_FUNCTION_H
+#define SCHWEFEL_FUNCTION_H
+
+#include "SeparableObjective.h"
+#include <cmath>
+
+// 最优解在 (420.9687, ..., 420.9687)。
+// 区间 [-500, 500] 之外按 CEC 2014 的改进 Schwefel 函数折回并加罚，
+// 使平移/旋转后落到区间外的点不会出现比最优解更小的值。
+// 常数 418.98 D 分到每一项中，各项在最优解附近都接近 0，单精度下求和不会由两个很大的数相减
+class SchwefelFunction : public SeparableObjective {
+public:
+    static constexpr double OPTIMUM = 420.968746;
+
+    SchwefelFunction(int dim): dimension(dim) {}
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        Scalar sum = 0;
+        for (int i = 0; i < dimension; ++i) {
+            sum += SchwefelFunction::term(i, x[i]);
+        }
+        return sum;
+    }
+    // 在 double 下计算后再转换，418.98 与 x sin(√|x|) 相减不损失精度
+    virtual Scalar term(int, Scalar value) const override {
+        double xi = value;
+        if (xi > 500) {
+            double r = 500 - fmod(xi, 500);
+            double d = xi - 500;
+            return static_cast<Scalar>(CONSTANT - r * sin(sqrt(fabs(r))) + d * d / (10000.0 * dimension));
+        }
+        if (xi < -500) {
+            double r = fmod(fabs(xi), 500) - 500;
+            double d = xi + 500;
+            return static_cast<Scalar>(CONSTANT - r * sin(sqrt(fabs(r))) + d * d / (10000.0 * dimension));
+        }
+        return static_cast<Scalar>(CONSTANT - xi * sin(sqrt(fabs(xi))));
+    }
+
+private:
+    static constexpr double CONSTANT = 418.9828872724339;
+
+    int dimension;
+};
+
+#endif // SCHWEFEL_FUNCTION_H
@@ -0,0 +1,39 @@
+#ifndef SEPARABLE_OBJECTIVE_H
+#define SEPARABLE_OBJECTIVE_H
+
+#include "ObjectiveFunction.h"
+
+// 可分离的目标函数：f(x) = offset() + Σ term(i, x[i])。
+// 只有 k 个坐标改变时可以用 update() 在 O(k) 时间内由原适应度得到新适应度。
+// 优化器在构造时检测目标函数是否实现了该接口，未实现时仍调用 eval()。
+// 增量先求两项之差再加到原适应度上，单精度下不会因为先加后减而损失有效位。
+class SeparableObjective : public ObjectiveFunction {
+public:
+    virtual Scalar term(int i, Scalar xi) const = 0;
+    virtual Scalar offset() const { return 0.0; }
+
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        Scalar sum = offset();
+        for (size_t i = 0; i < x.size(); ++i) {
+            sum += term(static_cast<int>(i), x[i]);
+        }
+        return sum;
+    }
+
+    // 第 i 个坐标由 oldValue 变为 newValue
+    Scalar update(Scalar fitness, int i, Scalar oldValue, Scalar newValue) const {
+        return fitness + (term(i, newValue) - term(i, oldValue));
+    }
+
+    // from 变为 to，changed 中列出了全部 k 个不同的坐标
+    Scalar update(Scalar fitness, const std::vector<Scalar>& from, const std::vector<Scalar>& to,
+                  const int* changed, int k) const {
+        for (int j = 0; j < k; ++j) {
+            int i = changed[j];
+            fitness += term(i, to[i]) - term(i, from[i]);
+        }
+        return fitness;
+    }
+};
+
+#endif // SEPARABLE_OBJECTIVE_H
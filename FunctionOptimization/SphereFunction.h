@@ -0,0 +1,24 @@
+#ifndef SPHERE_FUNCTION_H
+#define SPHERE_FUNCTION_H
+
+#include "SeparableObjective.h"
+
+class SphereFunction : public SeparableObjective {
+public:
+    SphereFunction(int dim): dimension(dim) {}
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        Scalar sum = 0;
+        for (int i = 0; i < dimension; ++i) {
+            sum += x[i] * x[i];
+        }
+        return sum;
+    }
+    virtual Scalar term(int, Scalar xi) const override {
+        return xi * xi;
+    }
+
+private:
+    int dimension;
+};
+
+#endif // SPHERE_FUNCTION_H
@@ -0,0 +1,113 @@
+#include "SteadyState.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+SteadyStateOptimizer::SteadyStateOptimizer(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax,
+                                           int minParents)
+    : objFunc(objFunc), DIM(dim), POP_SIZE(popSize), MAX_GEN(maxGen), X_MIN(xmin), X_MAX(xmax), MIN_PARENTS(minParents),
+      size(0), issued(0), pendingRandom(0), stopped(false), gen(rd())
+{
+    population.resize(POP_SIZE);
+    for (auto& ind : population) {
+        ind.position.resize(DIM);
+    }
+}
+
+void SteadyStateOptimizer::replaceWorst(const Individual& individual) {
+    auto worst = std::max_element(population.begin(), population.begin() + size,
+                                  [](const Individual& a, const Individual& b) {
+                                      return fitnessLess(a.fitness, b.fitness);
+                                  });
+    if (fitnessLess(individual.fitness, worst->fitness)) {
+        std::copy(individual.position.begin(), individual.position.end(), worst->position.begin());
+        worst->fitness = individual.fitness;
+    }
+}
+
+void SteadyStateOptimizer::work(int worker) {
+    Candidate& candidate = candidates[worker];
+    std::mt19937& g = workerGen[worker];
+    std::uniform_real_distribution<> dis_x(X_MIN, X_MAX);
+    long long budget = static_cast<long long>(POP_SIZE) * (MAX_GEN + 1);
+    if (maxEvaluations > 0) budget = std::min(budget, maxEvaluations);
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (issued == budget || stopped) return;
+            ++issued;
+            candidate.random = size + pendingRandom < POP_SIZE || size < MIN_PARENTS;
+            if (candidate.random) ++pendingRandom;
+            else propose(candidate, g);
+        }
+        if (candidate.random) {
+            for (auto& xi : candidate.individual.position) {
+                xi = dis_x(g);
+            }
+        }
+        // 评估在锁外进行，耗时再长也不阻塞其他线程
+        candidate.individual.fitness = objFunc.eval(candidate.individual.position);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!candidate.random) {
+            insert(candidate);
+        } else if (size < POP_SIZE) {
+            population[size].position = candidate.individual.position;
+            population[size].fitness = candidate.individual.fitness;
+            ++size;
+        } else {
+            replaceWorst(candidate.individual);
+        }
+        if (candidate.random) --pendingRandom;
+        ++evaluations;
+        if (telemetry.isEnabled() && evaluations > POP_SIZE && evaluations % POP_SIZE == 0) {
+            telemetry.beginGeneration(static_cast<int>(evaluations / POP_SIZE) - 2, evaluations);
+            for (int i = 0; i < size; ++i) {
+                telemetry.addRow(i, population[i].position.data(), population[i].fitness);
+            }
+            telemetry.endGeneration();
+        }
+        // 回调与终止条件也在锁内调用，此时种群不会被其他线程修改
+        if (evaluations > POP_SIZE && evaluations % POP_SIZE == 0 && checkProgress(static_cast<int>(evaluations / POP_SIZE) - 2)) {
+            stopped = true;
+        }
+    }
+}
+
+void SteadyStateOptimizer::run() {
+    // 每个线程池线程一个工作者；线程池忙时分段依次执行，先开始的工作者会用掉全部评估次数
+    int workers = pool ? pool->size() : 1;
+    if (static_cast<int>(candidates.size()) != workers) {
+        candidates.resize(workers);
+        for (auto& c : candidates) c.individual.position.resize(DIM);
+        workerGen.clear();
+        for (int w = 0; w < workers; ++w) workerGen.emplace_back(gen());
+    }
+    size = 0;
+    issued = 0;
+    pendingRandom = 0;
+    stopped = false;
+    evaluations = 0;
+    startProgress();
+    telemetry.beginRun(DIM, POP_SIZE, MAX_GEN);
+    auto body = [this](int, int begin, int end) {
+        for (int w = begin; w < end; ++w) work(w);
+    };
+    if (workers > 1) pool->parallelFor(workers, workers, body);
+    else body(0, 0, 1);
+    telemetry.endRun();
+}
+
+double SteadyStateOptimizer::getDiversity() const {
+    return populationDiversity(population, size);
+}
+
+int SteadyStateOptimizer::copyPopulation(Scalar* X, Scalar* fitness, int capacity) const {
+    return copyRows(population, size, X, fitness, capacity);
+}
+
+const Individual& SteadyStateOptimizer::getBestIndividual() const {
+    return *std::min_element(population.begin(), population.begin() + size,
+                             [](const Individual& a, const Individual& b) {
+                                 return fitnessLess(a.fitness, b.fitness);
+                             });
+}
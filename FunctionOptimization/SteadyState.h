@@ -0,0 +1,62 @@
+#ifndef STEADY_STATE_H
+#define STEADY_STATE_H
+
+#include "Optimizer.h"
+#include "ObjectiveFunction.h"
+#include <mutex>
+#include <random>
+#include <vector>
+
+// 稳态异步演化的公共部分，适用于评估耗时长且差异大的目标函数。
+// 每个工作线程反复地：在锁内由共享种群生成一个候选解，在锁外评估，评估完成后立即在锁内把它插回种群。
+// 没有代的概念也没有同步屏障，一个评估很慢时其他线程照常继续，锁只保护生成与插入这两步很短的操作。
+// 种群开始时为空，先由随机个体逐个填满，之后由子类的 propose/insert 决定如何产生与接纳候选解。
+// 总评估次数与分代版本相同，为 POP_SIZE * (MAX_GEN + 1)；遥测每插入 POP_SIZE 个候选解记录一代，不分阶段计时
+class SteadyStateOptimizer : public Optimizer {
+public:
+    virtual void run() override;
+    virtual const Individual& getBestIndividual() const override;
+    virtual double getDiversity() const override;
+    virtual int copyPopulation(Scalar* X, Scalar* fitness, int capacity) const override;
+
+protected:
+    struct Candidate {
+        Individual individual;
+        int target;      // 子类使用，例如 DE 的目标个体下标
+        bool random;     // 填充种群用的随机个体
+    };
+
+    // minParents 为生成候选解所需的最少个体数，种群中已评估的个体不足时继续产生随机个体
+    SteadyStateOptimizer(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax, int minParents);
+
+    // 以下两个函数在持有锁时调用，只能访问 population 的前 size 个个体
+    virtual void propose(Candidate& candidate, std::mt19937& g) = 0;
+    virtual void insert(const Candidate& candidate) = 0;
+    // 候选解优于最差个体时替换之
+    void replaceWorst(const Individual& individual);
+
+    const ObjectiveFunction& objFunc;
+    int DIM;
+    int POP_SIZE;
+    int MAX_GEN;
+    double X_MIN;
+    double X_MAX;
+    int MIN_PARENTS;
+
+    std::vector<Individual> population;
+    int size;                    // 已评估并放入种群的个体数
+
+private:
+    std::mutex mutex;
+    long long issued;            // 已分配出去的评估次数
+    int pendingRandom;           // 正在评估、将用于填充种群的随机个体数
+    bool stopped;                // 终止条件已满足，不再分配新的评估
+    std::vector<Candidate> candidates;
+    std::vector<std::mt19937> workerGen;
+    std::random_device rd;
+    std::mt19937 gen;
+
+    void work(int worker);
+};
+
+#endif // STEADY_STATE_H
@@ -0,0 +1,39 @@
+#include "SteadyStateDE.h"
+#include <algorithm>
+
+SteadyStateDE::SteadyStateDE(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double F, double CR, double xmin, double xmax)
+    : SteadyStateOptimizer(objFunc, dim, popSize, maxGen, xmin, xmax, 4), F(F), CR(CR)
+{
+}
+
+void SteadyStateDE::propose(Candidate& candidate, std::mt19937& g) {
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+    int target = g() % size;
+    int a, b, c;
+    do { a = g() % size; } while (a == target);
+    do { b = g() % size; } while (b == target || b == a);
+    do { c = g() % size; } while (c == target || c == a || c == b);
+
+    std::vector<Scalar>& trial = candidate.individual.position;
+    const std::vector<Scalar>& x = population[target].position;
+    const Scalar f = static_cast<Scalar>(F), lo = static_cast<Scalar>(X_MIN), hi = static_cast<Scalar>(X_MAX);
+    int rand_idx = g() % DIM;
+    for (int j = 0; j < DIM; ++j) {
+        if (dis(g) < CR || j == rand_idx) {
+            trial[j] = population[a].position[j] + f * (population[b].position[j] - population[c].position[j]);
+            if (trial[j] < lo) trial[j] = lo;
+            if (trial[j] > hi) trial[j] = hi;
+        } else {
+            trial[j] = x[j];
+        }
+    }
+    candidate.target = target;
+}
+
+void SteadyStateDE::insert(const Candidate& candidate) {
+    Individual& target = population[candidate.target];
+    if (fitnessLess(candidate.individual.fitness, target.fitness)) {
+        std::copy(candidate.individual.position.begin(), candidate.individual.position.end(), target.position.begin());
+        target.fitness = candidate.individual.fitness;
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef STEADY_STATE_DE_H
+#define STEADY_STATE_DE_H
+
+#include "SteadyState.h"
+
+// 稳态异步 DE：随机选一个目标个体，按 DE/rand/1/bin 生成试验个体，评估后若优于目标个体的当前值则替换之。
+// 评估期间目标个体可能已被其他线程替换，此时与替换后的个体比较
+class SteadyStateDE : public SteadyStateOptimizer {
+public:
+    SteadyStateDE(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double F, double CR, double xmin, double xmax);
+
+protected:
+    virtual void propose(Candidate& candidate, std::mt19937& g) override;
+    virtual void insert(const Candidate& candidate) override;
+
+private:
+    double F;
+    double CR;
+};
+
+#endif // STEADY_STATE_DE_H
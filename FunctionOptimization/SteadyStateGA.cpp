@@ -0,0 +1,36 @@
+#include "SteadyStateGA.h"
+#include <algorithm>
+
+SteadyStateGA::SteadyStateGA(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax,
+                             double mutationRate, double crossoverRate)
+    : SteadyStateOptimizer(objFunc, dim, popSize, maxGen, xmin, xmax, 2), mutationRate(mutationRate), crossoverRate(crossoverRate)
+{
+}
+
+int SteadyStateGA::selectParent(std::mt19937& g) const {
+    int a = g() % size;
+    int b = g() % size;
+    return fitnessLess(population[a].fitness, population[b].fitness) ? a : b;
+}
+
+void SteadyStateGA::propose(Candidate& candidate, std::mt19937& g) {
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+    std::uniform_real_distribution<> dis_x(X_MIN, X_MAX);
+    const Individual& p1 = population[selectParent(g)];
+    const Individual& p2 = population[selectParent(g)];
+    std::vector<Scalar>& child = candidate.individual.position;
+    if (dis(g) < crossoverRate) {
+        int cp = g() % DIM;
+        std::copy(p1.position.begin(), p1.position.begin() + cp, child.begin());
+        std::copy(p2.position.begin() + cp, p2.position.end(), child.begin() + cp);
+    } else {
+        std::copy(p1.position.begin(), p1.position.end(), child.begin());
+    }
+    for (int i = 0; i < DIM; ++i) {
+        if (dis(g) < mutationRate) child[i] = dis_x(g);
+    }
+}
+
+void SteadyStateGA::insert(const Candidate& candidate) {
+    replaceWorst(candidate.individual);
+}
@@ -0,0 +1,23 @@
+#ifndef STEADY_STATE_GA_H
+#define STEADY_STATE_GA_H
+
+#include "SteadyState.h"
+
+// 稳态异步 GA：锦标赛选出两个父代，单点交叉与均匀变异得到一个子代，评估后替换种群中最差的个体（若更好）
+class SteadyStateGA : public SteadyStateOptimizer {
+public:
+    SteadyStateGA(const ObjectiveFunction& objFunc, int dim, int popSize, int maxGen, double xmin, double xmax,
+                  double mutationRate, double crossoverRate);
+
+protected:
+    virtual void propose(Candidate& candidate, std::mt19937& g) override;
+    virtual void insert(const Candidate& candidate) override;
+
+private:
+    double mutationRate;
+    double crossoverRate;
+
+    int selectParent(std::mt19937& g) const;
+};
+
+#endif // STEADY_STATE_GA_H
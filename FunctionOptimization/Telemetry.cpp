@@ -0,0 +1,90 @@
+#include "Telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+void Telemetry::beginRun(int dim, int rows, int maxGen) {
+    stats.clear();
+    if (!enabled) return;
+    this->dim = dim;
+    // 预先分配好空间，记录过程中一般不再分配内存；max_gen 很大（如以 max_evals 或时间终止的运行）
+    // 时只预留前 RESERVE_LIMIT 代，之后按需增长，以免一次分配过多内存
+    stats.reserve(std::min(maxGen, RESERVE_LIMIT));
+    spread.reset(dim);
+    std::fill(phaseTime, phaseTime + NumPhases, 0.0);
+    if (snapshotWriter && snapshotInterval > 0) snapshotWriter->start(dim, rows);
+    runStart = Clock::now();
+    lastTick = runStart;
+}
+
+void Telemetry::endRun() {
+    if (enabled && snapshotWriter && snapshotInterval > 0) snapshotWriter->finish();
+}
+
+void Telemetry::beginGeneration(int generation, long long evaluations) {
+    current.generation = generation;
+    current.evaluations = evaluations;
+    current.best = std::numeric_limits<double>::infinity();
+    spread.reset(dim);
+    fitnessSum = 0.0;
+    count = 0;
+    snapshotActive = snapshotWriter && snapshotInterval > 0 && generation % snapshotInterval == 0
+                     && snapshotWriter->beginBlock(generation);
+}
+
+void Telemetry::endGeneration() {
+    if (snapshotActive) {
+        snapshotWriter->commitBlock();
+        snapshotActive = false;
+    }
+    current.elapsed = std::chrono::duration<double>(Clock::now() - runStart).count();
+    current.mean = count > 0 ? fitnessSum / count : 0.0;
+    current.diversity = count > 0 ? spread.value() : 0.0;
+    current.selectionTime = phaseTime[Selection];
+    current.variationTime = phaseTime[Variation];
+    current.evaluationTime = phaseTime[Evaluation];
+    std::fill(phaseTime, phaseTime + NumPhases, 0.0);
+    stats.push_back(current);
+}
+
+void Telemetry::mergeStats(const std::vector<const std::vector<GenerationStats>*>& parts, const std::vector<int>& rows) {
+    stats.clear();
+    if (!enabled || parts.empty()) return;
+    size_t generations = parts[0]->size();
+    double total = 0.0;
+    for (size_t p = 0; p < parts.size(); ++p) {
+        generations = std::min(generations, parts[p]->size());
+        total += rows[p];
+    }
+    for (size_t g = 0; g < generations; ++g) {
+        GenerationStats merged = (*parts[0])[g];
+        merged.evaluations = 0;
+        merged.best = std::numeric_limits<double>::infinity();
+        merged.mean = merged.diversity = 0.0;
+        merged.selectionTime = merged.variationTime = merged.evaluationTime = 0.0;
+        for (size_t p = 0; p < parts.size(); ++p) {
+            const GenerationStats& s = (*parts[p])[g];
+            double weight = rows[p] / total;
+            merged.elapsed = std::max(merged.elapsed, s.elapsed);
+            merged.evaluations += s.evaluations;
+            merged.best = std::min(merged.best, s.best);
+            merged.mean += weight * s.mean;
+            merged.diversity += weight * s.diversity * s.diversity;
+            merged.selectionTime += s.selectionTime;
+            merged.variationTime += s.variationTime;
+            merged.evaluationTime += s.evaluationTime;
+        }
+        merged.diversity = std::sqrt(merged.diversity);
+        stats.push_back(merged);
+    }
+}
+
+void Telemetry::writeCsv(const std::string& path) const {
+    std::ofstream file(path);
+    file << "Generation,Elapsed(s),Evaluations,Best,Mean,Diversity,Selection(s),Variation(s),Evaluation(s)\n";
+    for (const auto& s : stats) {
+        file << s.generation << "," << s.elapsed << "," << s.evaluations << "," << s.best << "," << s.mean << ","
+             << s.diversity << "," << s.selectionTime << "," << s.variationTime << "," << s.evaluationTime << "\n";
+    }
+}
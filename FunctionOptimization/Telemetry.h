@@ -0,0 +1,99 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "Termination.h"
+#include "TraceWriter.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+struct GenerationStats {
+    int generation;
+    double elapsed;            // 自本次运行开始的时间(s)
+    long long evaluations;     // 累计目标函数评估次数
+    double best;
+    double mean;
+    double diversity;          // 个体到种群中心的均方根距离
+    double selectionTime;      // 本代各阶段耗时(s)
+    double variationTime;
+    double evaluationTime;
+};
+
+// 运行时可开关的遥测：每代统计量、评估次数、分阶段计时，以及每隔 N 代一次的种群快照。
+// 关闭时所有记录接口只剩一次分支判断。
+class Telemetry {
+public:
+    enum Phase { Selection, Variation, Evaluation, NumPhases };
+
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+    // 每隔 interval 代把完整种群写入 writer，interval 为 0 表示不做快照
+    void setSnapshots(TraceWriter* writer, int interval) { snapshotWriter = writer; snapshotInterval = interval; }
+
+    const std::vector<GenerationStats>& getStats() const { return stats; }
+    void writeCsv(const std::string& path) const;
+
+    // 由优化器在 run() 开始和结束时调用
+    void beginRun(int dim, int rows, int maxGen);
+    void endRun();
+
+    // 阶段计时：startPhases() 开始计时，lap(p) 把上一次计时点以来的时间记到阶段 p 上
+    void startPhases() {
+        if (enabled) lastTick = Clock::now();
+    }
+    void lap(Phase phase) {
+        if (!enabled) return;
+        Clock::time_point now = Clock::now();
+        phaseTime[phase] += std::chrono::duration<double>(now - lastTick).count();
+        lastTick = now;
+    }
+
+    // 逐行记录一代的种群
+    void beginGeneration(int generation, long long evaluations);
+    void addRow(int row, const Scalar* x, Scalar fitness) {
+        if (fitness < current.best) current.best = fitness;
+        fitnessSum += fitness;
+        spread.add(x);
+        ++count;
+        if (snapshotActive) snapshotWriter->setRow(row, x, fitness);
+    }
+    void endGeneration();
+
+    // 用各自独立记录的子种群（如岛屿模型的各岛）的逐代统计代替本次运行的统计，rows 为各子种群的大小。
+    // 评估次数与各阶段耗时相加，平均值按大小加权，多样性取各子种群内多样性的均方根
+    void mergeStats(const std::vector<const std::vector<GenerationStats>*>& parts, const std::vector<int>& rows);
+
+    // 记录元素带有 position 与 fitness 成员的种群
+    template <typename T>
+    void recordPopulation(int generation, long long evaluations, const std::vector<T>& population) {
+        if (!enabled) return;
+        beginGeneration(generation, evaluations);
+        for (size_t i = 0; i < population.size(); ++i) {
+            addRow(static_cast<int>(i), population[i].position.data(), population[i].fitness);
+        }
+        endGeneration();
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    // beginRun 预留的最大代数
+    static const int RESERVE_LIMIT = 4096;
+
+    bool enabled = false;
+    TraceWriter* snapshotWriter = nullptr;
+    int snapshotInterval = 0;
+    bool snapshotActive = false;
+
+    int dim = 0;
+    std::vector<GenerationStats> stats;
+    Clock::time_point runStart;
+    Clock::time_point lastTick;
+    double phaseTime[NumPhases] = {};
+
+    GenerationStats current = {};
+    DiversityAccumulator spread;
+    double fitnessSum = 0.0;
+    int count = 0;
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,42 @@
+#include "Termination.h"
+#include "Optimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+bool WallTimeLimit::done(const Progress& progress) {
+    return progress.elapsed >= seconds;
+}
+
+bool TargetFitness::done(const Progress& progress) {
+    return progress.best->fitness <= target;
+}
+
+void Stagnation::reset() {
+    reference = std::numeric_limits<double>::infinity();
+    lastImprovement = 0;
+}
+
+bool Stagnation::done(const Progress& progress) {
+    // 以最近一次足够大的改进为基准，小于 tolerance 的改进不重新计数
+    if (progress.best->fitness < reference - tolerance) {
+        reference = progress.best->fitness;
+        lastImprovement = progress.generation;
+        return false;
+    }
+    return progress.generation - lastImprovement >= generations;
+}
+
+bool DiversityCollapse::done(const Progress& progress) {
+    return progress.diversity < threshold;
+}
+
+double populationDiversity(const std::vector<Individual>& population, int count) {
+    if (count <= 0) return std::numeric_limits<double>::quiet_NaN();
+    return rmsDistance([&population](int i) { return population[i].position.data(); }, count,
+                       static_cast<int>(population[0].position.size()));
+}
+
+double populationDiversity(const Scalar* X, int n, int dim) {
+    return rmsDistance([X, dim](int i) { return X + static_cast<size_t>(i) * dim; }, n, dim);
+}
@@ -0,0 +1,124 @@
+#ifndef TERMINATION_H
+#define TERMINATION_H
+
+#include "Scalar.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+struct Individual;
+
+// 一代结束时的运行进度，传给终止条件与进度回调。
+// best 指向算法内部保存的当前最优解，不做复制，只在回调期间有效
+struct Progress {
+    int generation;            // 刚完成的代（SA 每 D 步为一代，PT 为交换轮数），从 0 开始
+    long long evaluations;
+    double elapsed;            // 自 run() 开始的时间(s)
+    const Individual* best;
+    double diversity;          // 个体到种群中心的均方根距离，只有某个终止条件需要时才计算，否则为 NaN
+};
+
+// 终止条件：每代结束时调用 done()，任何一个条件返回 true 时 run() 提前结束
+class TerminationCriterion {
+public:
+    virtual ~TerminationCriterion() {}
+    // 每次 run() 开始时调用，清除上一次运行的状态
+    virtual void reset() {}
+    virtual bool needsDiversity() const { return false; }
+    virtual bool done(const Progress& progress) = 0;
+    // 用于 Optimizer::getStopReason()
+    virtual const char* name() const = 0;
+};
+
+// 运行时间达到 seconds 秒
+class WallTimeLimit : public TerminationCriterion {
+public:
+    explicit WallTimeLimit(double seconds) : seconds(seconds) {}
+    virtual bool done(const Progress& progress) override;
+    virtual const char* name() const override { return "max_time"; }
+
+private:
+    double seconds;
+};
+
+// 最优适应度不大于 target
+class TargetFitness : public TerminationCriterion {
+public:
+    explicit TargetFitness(double target) : target(target) {}
+    virtual bool done(const Progress& progress) override;
+    virtual const char* name() const override { return "target"; }
+
+private:
+    double target;
+};
+
+// 连续 generations 代最优适应度的下降都不超过 tolerance
+class Stagnation : public TerminationCriterion {
+public:
+    Stagnation(int generations, double tolerance = 0.0) : generations(generations), tolerance(tolerance) { reset(); }
+    virtual void reset() override;
+    virtual bool done(const Progress& progress) override;
+    virtual const char* name() const override { return "stagnation"; }
+
+private:
+    int generations;
+    double tolerance;
+    double reference;
+    int lastImprovement;
+};
+
+// 种群多样性低于 threshold，种群已收敛到一点附近。只有一个当前解的 SA/PT 不计算多样性，该条件对它们无效
+class DiversityCollapse : public TerminationCriterion {
+public:
+    explicit DiversityCollapse(double threshold) : threshold(threshold) {}
+    virtual bool needsDiversity() const override { return true; }
+    virtual bool done(const Progress& progress) override;
+    virtual const char* name() const override { return "diversity"; }
+
+private:
+    double threshold;
+};
+
+// 个体到种群中心的均方根距离，与遥测中的 Diversity 相同
+double populationDiversity(const std::vector<Individual>& population, int count);
+double populationDiversity(const Scalar* X, int n, int dim);
+
+// 逐个加入个体，得到它们到中心的均方根距离（Welford 算法，遥测与下面的 rmsDistance 共用）。
+// 不用一遍公式 E|x|^2 - |c|^2：种群远离原点时（如 Schwefel 的最优解在 420.97 附近）两项几乎相消，
+// 结果只剩舍入误差，单精度下更严重
+class DiversityAccumulator {
+public:
+    // 重复调用时不重新分配内存
+    void reset(int dim) {
+        mean.assign(dim, 0.0);
+        sumSquares = 0.0;
+        n = 0;
+    }
+    void add(const Scalar* x) {
+        double inv = 1.0 / ++n;
+        for (size_t d = 0; d < mean.size(); ++d) {
+            double delta = x[d] - mean[d];
+            mean[d] += delta * inv;
+            sumSquares += delta * (x[d] - mean[d]);
+        }
+    }
+    // 没有个体时为 NaN
+    double value() const { return n > 0 ? std::sqrt(std::max(0.0, sumSquares / n)) : std::numeric_limits<double>::quiet_NaN(); }
+
+private:
+    std::vector<double> mean;
+    double sumSquares = 0.0;   // 到当前中心的距离平方和
+    int n = 0;
+};
+
+// rows(i) 返回第 i 个个体的坐标，用于种群不在一块连续内存中的情形（如岛屿模型）
+template <typename Rows>
+double rmsDistance(Rows rows, int n, int dim) {
+    thread_local DiversityAccumulator accumulator;
+    accumulator.reset(dim);
+    for (int i = 0; i < n; ++i) accumulator.add(rows(i));
+    return accumulator.value();
+}
+
+#endif // TERMINATION_H
@@ -0,0 +1,154 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+// 当前线程所属的线程池及其队列编号，外部线程为 -1
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local int currentIndex = -1;
+}
+
+ThreadPool::ThreadPool(int threads)
+    : queued(0), pending(0), nextQueue(0), stopping(false)
+{
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < threads; ++i) {
+        queues.emplace_back(new Queue());
+    }
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    // 析构时不再报告任务中的异常
+    try {
+        wait();
+    } catch (...) {
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // 工作线程提交的任务放进自己的队列，外部提交的任务轮流分配
+    int index = currentPool == this ? currentIndex : static_cast<int>(nextQueue++ % queues.size());
+    pending++;
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    queued++;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    taskAvailable.notify_one();
+}
+
+bool ThreadPool::runOne(int self) {
+    std::function<void()> task;
+    int n = static_cast<int>(queues.size());
+    {
+        std::lock_guard<std::mutex> lock(queues[self]->mutex);
+        if (!queues[self]->tasks.empty()) {
+            task = std::move(queues[self]->tasks.back());
+            queues[self]->tasks.pop_back();
+        }
+    }
+    for (int k = 1; !task && k < n; ++k) {
+        int victim = (self + k) % n;
+        std::lock_guard<std::mutex> lock(queues[victim]->mutex);
+        if (!queues[victim]->tasks.empty()) {
+            task = std::move(queues[victim]->tasks.front());
+            queues[victim]->tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+
+    queued--;
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        if (!error) error = std::current_exception();
+    }
+    if (--pending == 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        allDone.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::workerLoop(int index) {
+    currentPool = this;
+    currentIndex = index;
+    while (true) {
+        if (runOne(index)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        taskAvailable.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) return;
+    }
+}
+
+void ThreadPool::parallelFor(int n, int chunks, const std::function<void(int, int, int)>& body) {
+    chunks = std::max(1, std::min(chunks, n));
+    if (chunks == 1) {
+        if (n > 0) body(0, 0, n);
+        return;
+    }
+    // 分段按领取顺序执行，提交出去的任务在分段都被领取后什么也不做。
+    // 状态由调用者和这些任务共同持有，晚到的任务不会访问已返回的栈帧
+    struct State {
+        std::atomic<int> next{0};
+        std::atomic<int> completed{0};
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;   // 第一个失败的分段抛出的异常，由 mutex 保护
+    };
+    auto state = std::make_shared<State>();
+    auto work = [state, n, chunks, &body] {
+        for (int c = state->next++; c < chunks; c = state->next++) {
+            try {
+                body(c, static_cast<int>(static_cast<long long>(n) * c / chunks),
+                     static_cast<int>(static_cast<long long>(n) * (c + 1) / chunks));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error) state->error = std::current_exception();
+            }
+            if (++state->completed == chunks) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->done.notify_all();
+            }
+        }
+    };
+    for (int c = 1; c < chunks; ++c) {
+        submit(work);
+    }
+    work();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->completed == chunks; });
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+void ThreadPool::wait() {
+    if (currentPool == this) throw std::logic_error("ThreadPool::wait() called from a task of the same pool");
+    // 外部线程只等待，不占用额外的核心
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        allDone.wait(lock, [this] { return pending == 0; });
+    }
+    rethrowError();
+}
+
+void ThreadPool::rethrowError() {
+    std::exception_ptr e;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        std::swap(e, error);
+    }
+    if (e) std::rethrow_exception(e);
+}
@@ -0,0 +1,61 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 工作窃取线程池：每个工作线程有自己的任务队列，从队尾取自己的任务，
+// 空闲时从其他线程的队首窃取。任务中需要等待子任务时使用 parallelFor()，wait() 只能在池外调用。
+// 任务抛出的异常不会结束工作线程：submit() 的任务中的第一个异常由下一次 wait() 重新抛出，
+// parallelFor() 的分段中的异常在所有分段结束后由 parallelFor() 抛出
+class ThreadPool {
+public:
+    // threads 为 0 时使用硬件线程数
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    int size() const { return static_cast<int>(workers.size()); }
+
+    void submit(std::function<void()> task);
+    // 等待所有已提交的任务执行完毕，有任务抛出异常时重新抛出其中第一个。
+    // 只能由池外的线程调用：调用者所在的任务本身也计入未完成的任务，在池中调用会永远等待，
+    // 因此抛出 std::logic_error
+    void wait();
+
+    // 把 [0, n) 均分成 chunks 段，并行执行 body(chunk, begin, end)，所有段完成后返回。
+    // 调用线程也领取分段执行，只等待本次调用的分段而不是整个线程池，
+    // 因此可以在池中的任务里嵌套调用
+    void parallelFor(int n, int chunks, const std::function<void(int, int, int)>& body);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<int> queued;
+    std::atomic<int> pending;
+    std::atomic<unsigned> nextQueue;
+    std::atomic<bool> stopping;
+
+    std::mutex sleepMutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable allDone;
+    std::exception_ptr error;   // 任务抛出的第一个异常，由 sleepMutex 保护
+
+    void rethrowError();
+
+    bool runOne(int self);
+    void workerLoop(int index);
+};
+
+#endif // THREAD_POOL_H
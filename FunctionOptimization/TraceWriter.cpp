@@ -0,0 +1,112 @@
+#include "TraceWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// 文件固定为小端；大端机器上写出前逐个数交换字节，小端机器上不做任何事
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const bool BIG_ENDIAN_HOST = true;
+#else
+const bool BIG_ENDIAN_HOST = false;
+#endif
+
+template <typename T>
+void toLittleEndian(T* values, size_t n) {
+    if (!BIG_ENDIAN_HOST) return;
+    for (size_t i = 0; i < n; ++i) {
+        unsigned char* p = reinterpret_cast<unsigned char*>(values + i);
+        std::reverse(p, p + sizeof(T));
+    }
+}
+
+}
+
+TraceWriter::TraceWriter(const std::string& path, size_t capacityBytes)
+    : path(path), capacityBytes(capacityBytes), dim(0), rows(0), memory(nullptr), block(nullptr), droppedBlocks(0), running(false)
+{
+}
+
+TraceWriter::~TraceWriter() {
+    finish();
+    ::operator delete(memory, std::align_val_t(64));
+}
+
+void TraceWriter::start(int dim, int rows) {
+    finish();
+    this->dim = dim;
+    this->rows = rows;
+    droppedBlocks = 0;
+
+    size_t blockSize = 1 + static_cast<size_t>(dim + 1) * rows;
+    size_t slots = std::max<size_t>(2, capacityBytes / (blockSize * sizeof(double)));
+    ::operator delete(memory, std::align_val_t(64));
+    memory = ::operator new(BlockRing::bytesRequired(slots, blockSize), std::align_val_t(64));
+    ring.reset(new BlockRing(memory, slots, blockSize));
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    char magic[8];
+    std::memcpy(magic, "OPTTRACE", 8);
+    uint32_t header[4] = { 1, static_cast<uint32_t>(dim), static_cast<uint32_t>(rows), 0 };
+    toLittleEndian(header, 4);
+    if (BIG_ENDIAN_HOST) swapBuffer.resize(blockSize);
+    out.write(magic, sizeof(magic));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    running.store(true, std::memory_order_release);
+    worker = std::thread(&TraceWriter::consume, this);
+}
+
+void TraceWriter::finish() {
+    if (!worker.joinable()) return;
+    running.store(false, std::memory_order_release);
+    worker.join();
+    out.close();
+}
+
+bool TraceWriter::beginBlock(int generation) {
+    block = ring ? ring->acquire() : nullptr;
+    if (!block) {
+        ++droppedBlocks;
+        return false;
+    }
+    block[0] = generation;
+    return true;
+}
+
+void TraceWriter::setRow(int row, const Scalar* x, Scalar fitness) {
+    for (int d = 0; d < dim; ++d) {
+        block[1 + d * rows + row] = x[d];
+    }
+    block[1 + dim * rows + row] = fitness;
+}
+
+void TraceWriter::commitBlock() {
+    ring->publish();
+    block = nullptr;
+}
+
+void TraceWriter::consume() {
+    const std::streamsize bytes = ring->getBlockSize() * sizeof(double);
+    while (true) {
+        const double* b = ring->peek();
+        if (b) {
+            if (BIG_ENDIAN_HOST) {
+                std::copy(b, b + ring->getBlockSize(), swapBuffer.begin());
+                toLittleEndian(swapBuffer.data(), swapBuffer.size());
+                b = swapBuffer.data();
+            }
+            out.write(reinterpret_cast<const char*>(b), bytes);
+            ring->release();
+            continue;
+        }
+        // 生产者结束后再检查一次，保证已发布的数据全部写出
+        if (!running.load(std::memory_order_acquire)) {
+            if (!ring->peek()) break;
+            continue;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
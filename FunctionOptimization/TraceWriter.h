@@ -0,0 +1,54 @@
+#ifndef TRACE_WRITER_H
+#define TRACE_WRITER_H
+
+#include "BlockRing.h"
+#include "Scalar.h"
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 二进制种群轨迹写入器。
+// 文件格式（小端，大端机器上由后台线程转换）：24 字节文件头 { char magic[8] = "OPTTRACE"; uint32 version; uint32 dim; uint32 rows; uint32 reserved; }，
+// 之后每一代一个定长数据块，共 1 + (dim + 1) * rows 个 double（单精度构建时也转换为 double），按列存放：
+// generation, x1[rows], x2[rows], ..., xD[rows], fitness[rows]。
+// 优化线程只向无锁环形缓冲区写入，由后台线程负责落盘；缓冲区满时丢弃该代而不是阻塞。
+class TraceWriter {
+public:
+    // capacityBytes 为环形缓冲区的总大小，决定了写入线程落后时最多能缓存多少代
+    explicit TraceWriter(const std::string& path, size_t capacityBytes = 4 << 20);
+    ~TraceWriter();
+
+    // 由优化器在 run() 开始时调用，分配缓冲区并启动后台线程
+    void start(int dim, int rows);
+    // 由优化器在 run() 结束时调用，等待后台线程写完剩余数据
+    void finish();
+
+    bool beginBlock(int generation);
+    void setRow(int row, const Scalar* x, Scalar fitness);
+    void commitBlock();
+
+    long long getDroppedBlocks() const { return droppedBlocks; }
+
+private:
+    std::string path;
+    size_t capacityBytes;
+    int dim;
+    int rows;
+
+    std::ofstream out;
+    void* memory;
+    std::unique_ptr<BlockRing> ring;
+    double* block;
+    std::vector<double> swapBuffer;   // 大端机器上转换字节序用的一个数据块
+    long long droppedBlocks;
+
+    std::thread worker;
+    std::atomic<bool> running;
+
+    void consume();
+};
+
+#endif // TRACE_WRITER_H
@@ -0,0 +1,147 @@
+#include "Transform.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <random>
+#include <tuple>
+
+namespace {
+
+// 列分段为 4 KB（512 个 double 或 1024 个 float），与 4 行矩阵数据一起留在 L1 中
+const int COLUMN_TILE_BYTES = 4096;
+
+// 随机正交矩阵：高斯矩阵做改进的 Gram-Schmidt 正交化
+void randomOrthogonal(double* Q, int n, std::mt19937_64& gen) {
+    std::normal_distribution<> normal(0.0, 1.0);
+    for (int i = 0; i < n * n; ++i) {
+        Q[i] = normal(gen);
+    }
+    for (int i = 0; i < n; ++i) {
+        double* qi = Q + static_cast<size_t>(i) * n;
+        for (int j = 0; j < i; ++j) {
+            const double* qj = Q + static_cast<size_t>(j) * n;
+            double dot = 0.0;
+            for (int k = 0; k < n; ++k) dot += qi[k] * qj[k];
+            for (int k = 0; k < n; ++k) qi[k] -= dot * qj[k];
+        }
+        double norm = 0.0;
+        for (int k = 0; k < n; ++k) norm += qi[k] * qi[k];
+        norm = std::sqrt(norm);
+        for (int k = 0; k < n; ++k) qi[k] /= norm;
+    }
+}
+
+}
+
+size_t packedSize(int rows, int cols) {
+    size_t panels = (rows + PANEL - 1) / PANEL;
+    return panels * PANEL * cols;
+}
+
+template <typename T>
+void packMatrix(const double* M, int rows, int cols, T* packed) {
+    for (int p = 0; p < rows; p += PANEL) {
+        for (int j = 0; j < cols; ++j) {
+            for (int r = 0; r < PANEL; ++r) {
+                *packed++ = static_cast<T>(p + r < rows ? M[static_cast<size_t>(p + r) * cols + j] : 0.0);
+            }
+        }
+    }
+}
+
+template <typename T>
+void matVec(const T* __restrict packed, int rows, int cols, const T* __restrict x, T* __restrict y) {
+    const int tile = COLUMN_TILE_BYTES / static_cast<int>(sizeof(T));
+    for (int i = 0; i < rows; ++i) y[i] = 0;
+    for (int c0 = 0; c0 < cols; c0 += tile) {
+        int c1 = std::min(cols, c0 + tile);
+        for (int p = 0; p < rows; p += PANEL) {
+            const T* P = packed + static_cast<size_t>(p) * cols;
+            // 奇偶列分别累加，两条互不依赖的加法链使乘加单元不必等待上一次加法的结果
+            T acc[PANEL] = {};
+            T odd[PANEL] = {};
+            int j = c0;
+            for (; j + 1 < c1; j += 2) {
+                T x0 = x[j];
+                T x1 = x[j + 1];
+                for (int r = 0; r < PANEL; ++r) acc[r] += P[j * PANEL + r] * x0;
+                for (int r = 0; r < PANEL; ++r) odd[r] += P[(j + 1) * PANEL + r] * x1;
+            }
+            if (j < c1) {
+                for (int r = 0; r < PANEL; ++r) acc[r] += P[j * PANEL + r] * x[j];
+            }
+            int n = std::min(PANEL, rows - p);
+            for (int r = 0; r < n; ++r) y[p + r] += acc[r] + odd[r];
+        }
+    }
+}
+
+template void packMatrix<float>(const double*, int, int, float*);
+template void packMatrix<double>(const double*, int, int, double*);
+template void matVec<float>(const float*, int, int, const float*, float*);
+template void matVec<double>(const double*, int, int, const double*, double*);
+
+Rotation::Rotation(int dim, int blockSize, uint64_t seed) : dim(dim), block(std::min(dim, blockSize)) {
+    std::mt19937_64 gen(seed);
+    size_t size = 0;
+    for (int b = 0; b < dim; b += block) {
+        int n = std::min(block, dim - b);
+        size += packedSize(n, n);
+    }
+    matrix.resize(size);
+    std::vector<double> Q(static_cast<size_t>(block) * block);
+    Scalar* packed = matrix.data();
+    for (int b = 0; b < dim; b += block) {
+        int n = std::min(block, dim - b);
+        randomOrthogonal(Q.data(), n, gen);
+        packMatrix(Q.data(), n, n, packed);
+        packed += packedSize(n, n);
+    }
+}
+
+void Rotation::apply(const Scalar* x, Scalar* y) const {
+    const Scalar* Q = matrix.data();
+    for (int b = 0; b < dim; b += block) {
+        int n = std::min(block, dim - b);
+        matVec(Q, n, n, x + b, y + b);
+        Q += packedSize(n, n);
+    }
+}
+
+namespace {
+
+std::mutex cacheMutex;
+std::map<std::tuple<int, int, uint64_t>, std::weak_ptr<const Rotation>> rotationCache;
+std::map<std::tuple<int, double, double, uint64_t>, std::weak_ptr<const std::vector<Scalar>>> shiftCache;
+
+}
+
+std::shared_ptr<const Rotation> sharedRotation(int dim, int blockSize, uint64_t seed) {
+    // 生成 D = 10^4 的旋转需要约 10^8 次运算，持锁生成以免多个线程重复计算
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& slot = rotationCache[std::make_tuple(dim, blockSize, seed)];
+    std::shared_ptr<const Rotation> rotation = slot.lock();
+    if (!rotation) {
+        rotation = std::make_shared<const Rotation>(dim, blockSize, seed);
+        slot = rotation;
+    }
+    return rotation;
+}
+
+std::shared_ptr<const std::vector<Scalar>> sharedShift(int dim, double xmin, double xmax, uint64_t seed) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& slot = shiftCache[std::make_tuple(dim, xmin, xmax, seed)];
+    std::shared_ptr<const std::vector<Scalar>> shift = slot.lock();
+    if (!shift) {
+        // 最优解平移到区间中间 80% 的范围内
+        double margin = 0.1 * (xmax - xmin);
+        std::mt19937_64 gen(seed);
+        std::uniform_real_distribution<> dis(xmin + margin, xmax - margin);
+        auto o = std::make_shared<std::vector<Scalar>>(dim);
+        for (auto& oi : *o) oi = static_cast<Scalar>(dis(gen));
+        shift = o;
+        slot = shift;
+    }
+    return shift;
+}
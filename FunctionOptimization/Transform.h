@@ -0,0 +1,48 @@
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include "Scalar.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// CEC 风格的平移/旋转所需的数据。
+// 旋转矩阵是分块对角的正交矩阵：D <= blockSize 时就是一个完整的 D×D 旋转，
+// 更高维时每 blockSize 个坐标一组各自旋转（与 CEC 2013 大规模测试集的做法相同），
+// 否则 D = 10^4 时一个稠密矩阵要 800 MB，一次评估也要 10^8 次乘加。
+class Rotation {
+public:
+    Rotation(int dim, int blockSize, uint64_t seed);
+
+    int dimension() const { return dim; }
+    int blockSize() const { return block; }
+
+    // y = M x，x 与 y 不能重叠
+    void apply(const Scalar* x, Scalar* y) const;
+
+private:
+    int dim;
+    int block;
+    std::vector<Scalar> matrix;   // 各块按 packMatrix 的格式依次存放
+};
+
+// 矩阵-向量乘法使用的打包格式：每 PANEL 行为一组（最后一组不足时补零行），
+// 组内按列存放，即第 p 组第 j 列的 PANEL 个元素连续。
+// 这样内层循环对 PANEL 个互不相关的累加器做同样的乘加，不需要 -ffast-math 也能向量化。
+// T 为 float 或 double：目标函数的旋转按 Scalar 计算，CMA-ES 的采样总是用 double
+const int PANEL = 4;
+size_t packedSize(int rows, int cols);
+// M 为 rows×cols 的行优先矩阵
+template <typename T>
+void packMatrix(const double* M, int rows, int cols, T* packed);
+// y = M x，packed 由 packMatrix 得到，x 与 y 不能重叠。
+// 按列分段计算，x 的一段留在 L1 中被所有行组复用
+template <typename T>
+void matVec(const T* packed, int rows, int cols, const T* x, T* y);
+
+// 相同参数的旋转矩阵与平移向量只生成一次，由所有线程上的目标函数共享，
+// 最后一个使用者释放后回收
+std::shared_ptr<const Rotation> sharedRotation(int dim, int blockSize, uint64_t seed);
+std::shared_ptr<const std::vector<Scalar>> sharedShift(int dim, double xmin, double xmax, uint64_t seed);
+
+#endif // TRANSFORM_H
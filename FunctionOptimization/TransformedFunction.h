@@ -0,0 +1,62 @@
+#ifndef TRANSFORMED_FUNCTION_H
+#define TRANSFORMED_FUNCTION_H
+
+#include "SeparableObjective.h"
+#include "Transform.h"
+#include <memory>
+
+// CEC 风格的变换：F(x) = f(M (x - o) + c)，o 为平移后的最优解，
+// c 为原函数最优解所在的坐标（Rosenbrock 为 1，Schwefel 为 420.9687，其余为 0）。
+// rotation 为空时只平移
+class ShiftedRotatedFunction : public ObjectiveFunction {
+public:
+    ShiftedRotatedFunction(std::unique_ptr<ObjectiveFunction> base, std::shared_ptr<const std::vector<Scalar>> shift,
+                           std::shared_ptr<const Rotation> rotation, double center = 0.0)
+        : base(std::move(base)), shift(std::move(shift)), rotation(std::move(rotation)), center(center) {}
+
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        // 每个线程一份缓冲区，目标函数可以被多个线程同时调用
+        thread_local std::vector<Scalar> t;
+        thread_local std::vector<Scalar> z;
+        const std::vector<Scalar>& o = *shift;
+        size_t n = x.size();
+        t.resize(n);
+        z.resize(n);
+        for (size_t i = 0; i < n; ++i) t[i] = x[i] - o[i];
+        if (rotation) {
+            rotation->apply(t.data(), z.data());
+        } else {
+            z.swap(t);
+        }
+        for (size_t i = 0; i < n; ++i) z[i] += center;
+        return base->eval(z);
+    }
+
+private:
+    std::unique_ptr<ObjectiveFunction> base;
+    std::shared_ptr<const std::vector<Scalar>> shift;
+    std::shared_ptr<const Rotation> rotation;
+    Scalar center;
+};
+
+// 平移不破坏可分离性，平移后的可分离函数仍可以增量评估
+class ShiftedSeparableFunction : public SeparableObjective {
+public:
+    ShiftedSeparableFunction(std::unique_ptr<SeparableObjective> base, std::shared_ptr<const std::vector<Scalar>> shift,
+                             double center = 0.0)
+        : base(std::move(base)), shift(std::move(shift)), center(center) {}
+
+    virtual Scalar term(int i, Scalar xi) const override {
+        return base->term(i, xi - (*shift)[i] + center);
+    }
+    virtual Scalar offset() const override {
+        return base->offset();
+    }
+
+private:
+    std::unique_ptr<SeparableObjective> base;
+    std::shared_ptr<const std::vector<Scalar>> shift;
+    Scalar center;
+};
+
+#endif // TRANSFORMED_FUNCTION_H
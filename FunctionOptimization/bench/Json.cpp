@@ -0,0 +1,201 @@
+#include "Json.h"
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <stdexcept>
+
+JsonValue& JsonValue::set(const std::string& key, const JsonValue& v) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] == key) return elements[i] = v;
+    }
+    keys.push_back(key);
+    elements.push_back(v);
+    return elements.back();
+}
+
+const JsonValue* JsonValue::get(const std::string& key) const {
+    if (type != Object) return nullptr;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] == key) return &elements[i];
+    }
+    return nullptr;
+}
+
+namespace {
+
+void writeString(std::ostream& out, const std::string& s) {
+    out << '"';
+    for (char c : s) {
+        switch (c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+            } else {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+}
+
+void JsonValue::write(std::ostream& out, int indent) const {
+    std::string pad(indent + 2, ' ');
+    switch (type) {
+    case Null: out << "null"; break;
+    case Bool: out << (number != 0.0 ? "true" : "false"); break;
+    case Number:
+        // JSON 没有 inf/nan，写成 null
+        if (std::isfinite(number)) out << std::setprecision(10) << number;
+        else out << "null";
+        break;
+    case String: writeString(out, str); break;
+    case Array:
+    case Object: {
+        bool isObject = type == Object;
+        out << (isObject ? '{' : '[');
+        if (elements.empty()) { out << (isObject ? '}' : ']'); break; }
+        // 只含数字/字符串的短数组写在一行
+        bool flat = !isObject;
+        for (const auto& e : elements) flat = flat && e.type != Array && e.type != Object;
+        for (size_t i = 0; i < elements.size(); ++i) {
+            out << (i ? "," : "");
+            if (flat) {
+                out << (i ? " " : "");
+            } else {
+                out << "\n" << pad;
+            }
+            if (isObject) { writeString(out, keys[i]); out << ": "; }
+            elements[i].write(out, indent + 2);
+        }
+        if (!flat) out << "\n" << std::string(indent, ' ');
+        out << (isObject ? '}' : ']');
+        break;
+    }
+    }
+}
+
+namespace {
+
+class Parser {
+public:
+    explicit Parser(const std::string& text) : s(text) {}
+
+    JsonValue parseDocument() {
+        JsonValue v = parseValue();
+        skipSpace();
+        if (pos != s.size()) fail("trailing characters");
+        return v;
+    }
+
+private:
+    const std::string& s;
+    size_t pos = 0;
+
+    [[noreturn]] void fail(const std::string& what) {
+        throw std::runtime_error("JSON: " + what + " at offset " + std::to_string(pos));
+    }
+
+    void skipSpace() {
+        while (pos < s.size() && (s[pos] == ' ' || s[pos] == '\n' || s[pos] == '\r' || s[pos] == '\t')) ++pos;
+    }
+
+    bool consume(const char* word) {
+        size_t n = std::char_traits<char>::length(word);
+        if (s.compare(pos, n, word) != 0) return false;
+        pos += n;
+        return true;
+    }
+
+    void expect(char c) {
+        skipSpace();
+        if (pos >= s.size() || s[pos] != c) fail(std::string("expected '") + c + "'");
+        ++pos;
+    }
+
+    JsonValue parseValue() {
+        skipSpace();
+        if (pos >= s.size()) fail("unexpected end");
+        char c = s[pos];
+        if (c == '{') return parseObject();
+        if (c == '[') return parseArray();
+        if (c == '"') return JsonValue(parseString());
+        if (consume("true")) return JsonValue(true);
+        if (consume("false")) return JsonValue(false);
+        if (consume("null")) return JsonValue();
+        const char* begin = s.c_str() + pos;
+        char* end = nullptr;
+        double x = std::strtod(begin, &end);
+        if (end == begin) fail("invalid value");
+        pos += end - begin;
+        return JsonValue(x);
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string out;
+        while (pos < s.size() && s[pos] != '"') {
+            char c = s[pos++];
+            if (c != '\\') { out += c; continue; }
+            if (pos >= s.size()) break;
+            char e = s[pos++];
+            switch (e) {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u': {
+                // 结果文件中只会出现 ASCII 控制字符的转义
+                if (pos + 4 > s.size()) fail("bad escape");
+                out += static_cast<char>(std::strtol(s.substr(pos, 4).c_str(), nullptr, 16));
+                pos += 4;
+                break;
+            }
+            default: out += e;
+            }
+        }
+        expect('"');
+        return out;
+    }
+
+    JsonValue parseArray() {
+        expect('[');
+        JsonValue v = JsonValue::array();
+        skipSpace();
+        if (pos < s.size() && s[pos] == ']') { ++pos; return v; }
+        do {
+            v.push(parseValue());
+            skipSpace();
+        } while (pos < s.size() && s[pos] == ',' && ++pos);
+        expect(']');
+        return v;
+    }
+
+    JsonValue parseObject() {
+        expect('{');
+        JsonValue v = JsonValue::object();
+        skipSpace();
+        if (pos < s.size() && s[pos] == '}') { ++pos; return v; }
+        do {
+            skipSpace();
+            std::string key = parseString();
+            expect(':');
+            v.set(key, parseValue());
+            skipSpace();
+        } while (pos < s.size() && s[pos] == ',' && ++pos);
+        expect('}');
+        return v;
+    }
+};
+
+}
+
+JsonValue parseJson(const std::string& text) {
+    return Parser(text).parseDocument();
+}
@@ -0,0 +1,49 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 基准测试结果用的最小 JSON 值：写出结果文件，并读回基线文件做比较
+class JsonValue {
+public:
+    enum Type { Null, Bool, Number, String, Array, Object };
+
+    JsonValue() : type(Null) {}
+    JsonValue(bool b) : type(Bool), number(b ? 1.0 : 0.0) {}
+    JsonValue(double x) : type(Number), number(x) {}
+    JsonValue(int x) : type(Number), number(x) {}
+    JsonValue(long long x) : type(Number), number(static_cast<double>(x)) {}
+    JsonValue(const char* s) : type(String), str(s) {}
+    JsonValue(const std::string& s) : type(String), str(s) {}
+
+    static JsonValue array() { JsonValue v; v.type = Array; return v; }
+    static JsonValue object() { JsonValue v; v.type = Object; return v; }
+
+    Type getType() const { return type; }
+    double asNumber() const { return number; }
+    const std::string& asString() const { return str; }
+    const std::vector<JsonValue>& items() const { return elements; }
+
+    // 数组追加元素，对象追加键值对（按插入顺序输出）
+    JsonValue& push(const JsonValue& v) { elements.push_back(v); return elements.back(); }
+    JsonValue& set(const std::string& key, const JsonValue& v);
+    // 对象中查找键，不存在时返回 nullptr
+    const JsonValue* get(const std::string& key) const;
+
+    void write(std::ostream& out, int indent = 0) const;
+
+private:
+    Type type;
+    double number = 0.0;
+    std::string str;
+    std::vector<JsonValue> elements;
+    std::vector<std::string> keys;   // 对象的键，与 elements 一一对应
+};
+
+// 解析失败时抛出 std::runtime_error
+JsonValue parseJson(const std::string& text);
+
+#endif // JSON_H
@@ -0,0 +1,71 @@
+// 检查 SA、GA、PSO、DE 的运行循环不分配堆内存：替换全局 operator new 计数，
+// 每个优化器（打开遥测）连续运行两次，第一次允许分配缓冲区，第二次分配了内存则失败。
+// 用法：make alloc_check && ./alloc_check，返回值 0 表示通过
+#include "../Factory.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<long long> allocations(0);
+
+void* allocate(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    ++allocations;
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    ++allocations;
+    return std::malloc(size ? size : 1);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    const int dim = 30;
+    const std::vector<std::string> algorithms = {"SA", "GA", "PSO", "DE"};
+    const std::vector<std::string> functions = {"rastrigin", "shifted_rotated_rastrigin"};
+    int failures = 0;
+    try {
+        for (const auto& function : functions) {
+            std::unique_ptr<ObjectiveFunction> objFunc = createObjective(function, dim);
+            double xmin, xmax;
+            defaultBounds(function, xmin, xmax);
+            for (const auto& algorithm : algorithms) {
+                std::unique_ptr<Optimizer> optimizer = createOptimizer(algorithm, *objFunc, dim, xmin, xmax,
+                                                                       {{"pop_size", 40}, {"max_gen", 100}});
+                optimizer->getTelemetry().setEnabled(true);
+                optimizer->run();
+                long long before = allocations.load();
+                optimizer->run();
+                long long count = allocations.load() - before;
+                std::cout << function << " " << algorithm << ": " << count << " allocations in the second run\n";
+                if (count != 0) ++failures;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 2;
+    }
+    if (failures > 0) {
+        std::cout << failures << " optimizer(s) allocated memory in a repeated run" << std::endl;
+        return 1;
+    }
+    std::cout << "no allocations in repeated runs" << std::endl;
+    return 0;
+}
@@ -0,0 +1,531 @@
+// 优化算法与目标函数的性能基准：评估吞吐量、每代耗时与达到目标适应度的时间分布，
+// 结果写成 JSON，并可与之前保存的基线比较以发现性能退化。用法见 usage()
+#include "Json.h"
+#include "../Factory.h"
+#include "../ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Target {
+    std::string function;
+    int dim;
+    double fitness;
+};
+
+// 传给优化器的参数，algorithm 为空时对所有算法生效
+struct Param {
+    std::string algorithm;
+    std::string key;
+    double value;
+};
+
+struct Options {
+    std::vector<std::string> functions = {"rastrigin", "shifted_rotated_rastrigin"};
+    std::vector<std::string> algorithms = {"SA", "GA", "PSO", "DE"};
+    std::vector<int> dims = {10, 100, 1000};
+    std::vector<int> pops = {50};
+    int generations = 200;
+    int repeat = 5;
+    int warmup = 1;
+    std::vector<Target> targets = {{"rastrigin", 10, 20.0}, {"sphere", 10, 1.0}};
+    int targetRuns = 20;
+    int targetGenerations = 500;
+    int cpu = -1;
+    std::string output = "bench.json";
+    std::string baseline;
+    double tolerance = 0.10;
+    std::vector<Param> params;
+    int threads = 0;
+    ThreadPool* pool = nullptr;
+    bool objectives = true;
+    bool optimizers = true;
+    bool timeToTarget = true;
+};
+
+void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [options]\n"
+              << "  --functions a,b        objective functions (default rastrigin,shifted_rotated_rastrigin)\n"
+              << "  --algorithms a,b       optimizers (default SA,GA,PSO,DE)\n"
+              << "  --dims 10,100          dimensions (default 10,100,1000)\n"
+              << "  --pops 50,100          population sizes (default 50)\n"
+              << "  --generations N        generations per timed run (default 200)\n"
+              << "  --repeat N             timed repetitions, the median is reported (default 5)\n"
+              << "  --warmup N             untimed runs before measuring (default 1)\n"
+              << "  --target f:dim:value   time-to-target case, may be repeated (default rastrigin:10:20, sphere:10:1)\n"
+              << "  --target-runs N        runs per time-to-target case (default 20)\n"
+              << "  --target-generations N generation limit of a time-to-target run (default 500)\n"
+              << "  --param [ALG.]key=v    optimizer parameter, e.g. PSO.synchronous=1, may be repeated\n"
+              << "  --threads N            thread pool for optimizers that parallelize inside a run\n"
+              << "  --only list            subset of objectives,optimizers,targets\n"
+              << "  --cpu N                pin the benchmark to CPU N\n"
+              << "  --output file          JSON result file (default bench.json)\n"
+              << "  --baseline file        compare with an earlier result, exit code 2 on regression\n"
+              << "  --tolerance x          allowed slowdown against the baseline (default 0.10)\n";
+}
+
+std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> items;
+    std::stringstream in(s);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+std::vector<int> splitInts(const std::string& s) {
+    std::vector<int> values;
+    for (const auto& item : splitList(s)) values.push_back(std::stoi(item));
+    return values;
+}
+
+Target parseTarget(const std::string& s) {
+    std::vector<std::string> parts;
+    std::stringstream in(s);
+    std::string part;
+    while (std::getline(in, part, ':')) parts.push_back(part);
+    if (parts.size() != 3) throw std::invalid_argument("--target expects function:dim:value, got '" + s + "'");
+    return Target{parts[0], std::stoi(parts[1]), std::stod(parts[2])};
+}
+
+Param parseParam(const std::string& s) {
+    size_t eq = s.find('=');
+    if (eq == std::string::npos) throw std::invalid_argument("--param expects [ALG.]key=value, got '" + s + "'");
+    Param p;
+    p.key = s.substr(0, eq);
+    p.value = std::stod(s.substr(eq + 1));
+    size_t dot = p.key.find('.');
+    if (dot != std::string::npos) {
+        p.algorithm = p.key.substr(0, dot);
+        p.key = p.key.substr(dot + 1);
+        std::transform(p.algorithm.begin(), p.algorithm.end(), p.algorithm.begin(),
+                       [](unsigned char c) { return std::toupper(c); });
+    }
+    return p;
+}
+
+Options parseOptions(int argc, char* argv[]) {
+    Options opt;
+    bool defaultTargets = true;
+    for (int a = 1; a < argc; ++a) {
+        std::string arg = argv[a];
+        if (arg == "-h" || arg == "--help") { usage(argv[0]); std::exit(0); }
+        if (a + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+        std::string value = argv[++a];
+        if (arg == "--functions") opt.functions = splitList(value);
+        else if (arg == "--algorithms") {
+            opt.algorithms = splitList(value);
+            for (auto& a : opt.algorithms) {
+                std::transform(a.begin(), a.end(), a.begin(), [](unsigned char c) { return std::toupper(c); });
+            }
+        }
+        else if (arg == "--dims") opt.dims = splitInts(value);
+        else if (arg == "--pops") opt.pops = splitInts(value);
+        else if (arg == "--generations") opt.generations = std::stoi(value);
+        else if (arg == "--repeat") opt.repeat = std::max(1, std::stoi(value));
+        else if (arg == "--warmup") opt.warmup = std::max(0, std::stoi(value));
+        else if (arg == "--target") {
+            if (defaultTargets) opt.targets.clear();
+            defaultTargets = false;
+            opt.targets.push_back(parseTarget(value));
+        }
+        else if (arg == "--target-runs") opt.targetRuns = std::stoi(value);
+        else if (arg == "--target-generations") opt.targetGenerations = std::stoi(value);
+        else if (arg == "--only") {
+            std::vector<std::string> parts = splitList(value);
+            auto has = [&](const char* p) { return std::find(parts.begin(), parts.end(), p) != parts.end(); };
+            opt.objectives = has("objectives");
+            opt.optimizers = has("optimizers");
+            opt.timeToTarget = has("targets");
+        }
+        else if (arg == "--param") opt.params.push_back(parseParam(value));
+        else if (arg == "--threads") opt.threads = std::stoi(value);
+        else if (arg == "--cpu") opt.cpu = std::stoi(value);
+        else if (arg == "--output") opt.output = value;
+        else if (arg == "--baseline") opt.baseline = value;
+        else if (arg == "--tolerance") opt.tolerance = std::stod(value);
+        else throw std::invalid_argument("unknown option " + arg);
+    }
+    return opt;
+}
+
+// 把基准固定在一个 CPU 上，避免调度器在核之间迁移带来的抖动
+bool pinToCpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// 进程的峰值常驻内存(KB)，不支持时为 -1。单独运行一个用例即可得到该用例的内存占用
+long peakMemoryKb() {
+#ifdef __linux__
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss;
+#endif
+    return -1;
+}
+
+std::string cpuModel() {
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.compare(0, 10, "model name") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+        }
+    }
+    return "unknown";
+}
+
+double quantile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return NAN;
+    double pos = q * (sorted.size() - 1);
+    size_t lo = static_cast<size_t>(pos);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (pos - lo) * (sorted[hi] - sorted[lo]);
+}
+
+// 重复测量的汇总：中位数用于比较，最小值接近无干扰时的耗时
+JsonValue summarize(std::vector<double> values, bool quartiles = false) {
+    std::sort(values.begin(), values.end());
+    JsonValue s = JsonValue::object();
+    s.set("median", quantile(values, 0.5));
+    s.set("min", quantile(values, 0.0));
+    if (quartiles) {
+        s.set("p25", quantile(values, 0.25));
+        s.set("p75", quantile(values, 0.75));
+    }
+    s.set("max", quantile(values, 1.0));
+    return s;
+}
+
+bool applies(const Param& p, const std::string& algorithm) {
+    return p.algorithm.empty() || p.algorithm == algorithm;
+}
+
+// 用例名称包含对该算法生效的参数，与基线比较时只匹配相同设置的用例
+std::string caseName(const std::string& algorithm, const std::string& function, int dim, int pop, const Options& opt) {
+    std::ostringstream name;
+    name << algorithm << "/" << function << "/D" << dim << "/P" << pop;
+    for (const auto& p : opt.params) {
+        if (applies(p, algorithm)) name << "/" << p.key << "=" << p.value;
+    }
+    return name.str();
+}
+
+// SA 每代只评估一次，给它 pop 倍的迭代次数；PT 的副本再平分这些迭代，使所有算法的评估预算相同
+int budget(const std::string& algorithm, int generations, int pop, const Options& opt) {
+    if (algorithm == "SA") return generations * pop;
+    if (algorithm == "PT") {
+        int replicas = 8;   // 与 createOptimizer 的默认值一致
+        for (const auto& p : opt.params) {
+            if (applies(p, algorithm) && p.key == "replicas") replicas = static_cast<int>(p.value);
+        }
+        return std::max(1, generations * pop / std::max(1, replicas));
+    }
+    return generations;
+}
+
+std::unique_ptr<Optimizer> makeOptimizer(const std::string& algorithm, const ObjectiveFunction& objective,
+                                         const std::string& function, int dim, int pop, int generations, const Options& opt) {
+    double xmin, xmax;
+    defaultBounds(function, xmin, xmax);
+    ParameterSet params;
+    params["pop_size"] = pop;
+    params["max_gen"] = budget(algorithm, generations, pop, opt);
+    for (const auto& p : opt.params) {
+        if (applies(p, algorithm)) params[p.key] = p.value;
+    }
+    std::unique_ptr<Optimizer> optimizer = createOptimizer(algorithm, objective, dim, xmin, xmax, params);
+    optimizer->setThreadPool(opt.pool);
+    return optimizer;
+}
+
+// 目标函数吞吐量：先加倍迭代次数直到一批耗时超过 20 ms（同时作为预热），再按该批量重复测量
+JsonValue benchObjective(const std::string& function, int dim, const Options& opt) {
+    std::unique_ptr<ObjectiveFunction> objective = createObjective(function, dim);
+    double xmin, xmax;
+    defaultBounds(function, xmin, xmax);
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<> dis(xmin, xmax);
+    std::vector<Scalar> x(dim);
+    for (auto& xi : x) xi = dis(gen);
+
+    // 每次评估前改变一个坐标，防止编译器把评估提到循环外
+    volatile double sink = 0.0;
+    auto batch = [&](long long n) {
+        Clock::time_point start = Clock::now();
+        double sum = 0.0;
+        for (long long i = 0; i < n; ++i) {
+            x[i % dim] = dis(gen);
+            sum += objective->eval(x);
+        }
+        sink = sink + sum;
+        return seconds(start);
+    };
+    long long n = 1;
+    while (batch(n) < 0.02) n *= 2;
+    for (int w = 0; w < opt.warmup; ++w) batch(n);
+
+    std::vector<double> nsPerEval, evalsPerSec;
+    for (int r = 0; r < opt.repeat; ++r) {
+        double t = batch(n);
+        nsPerEval.push_back(t / n * 1e9);
+        evalsPerSec.push_back(n / t);
+    }
+    JsonValue result = JsonValue::object();
+    result.set("name", function + "/D" + std::to_string(dim));
+    result.set("function", function);
+    result.set("dim", dim);
+    result.set("evaluations_per_batch", n);
+    result.set("ns_per_eval", summarize(nsPerEval));
+    result.set("evals_per_sec", summarize(evalsPerSec));
+    return result;
+}
+
+// 优化器：同一个实例反复 run()，预热的运行不计时
+JsonValue benchOptimizer(const std::string& algorithm, const std::string& function, int dim, int pop, const Options& opt) {
+    std::unique_ptr<ObjectiveFunction> objective = createObjective(function, dim);
+    std::unique_ptr<Optimizer> optimizer = makeOptimizer(algorithm, *objective, function, dim, pop, opt.generations, opt);
+    int generations = budget(algorithm, opt.generations, pop, opt);
+
+    for (int w = 0; w < opt.warmup; ++w) optimizer->run();
+    std::vector<double> nsPerGen, evalsPerSec, best;
+    for (int r = 0; r < opt.repeat; ++r) {
+        Clock::time_point start = Clock::now();
+        optimizer->run();
+        double t = seconds(start);
+        nsPerGen.push_back(t / generations * 1e9);
+        evalsPerSec.push_back(optimizer->getEvaluationCount() / t);
+        best.push_back(optimizer->getBestIndividual().fitness);
+    }
+    JsonValue result = JsonValue::object();
+    result.set("name", caseName(algorithm, function, dim, pop, opt));
+    result.set("algorithm", algorithm);
+    result.set("function", function);
+    result.set("dim", dim);
+    result.set("pop_size", pop);
+    result.set("generations", generations);
+    result.set("evaluations", optimizer->getEvaluationCount());
+    result.set("ns_per_gen", summarize(nsPerGen));
+    result.set("evals_per_sec", summarize(evalsPerSec));
+    result.set("best_fitness", summarize(best));
+    return result;
+}
+
+// 达到目标适应度的时间与评估次数分布，取遥测记录中第一个最优值不超过目标的代。
+// 开启遥测本身有开销，评估次数不受影响，可用于跨机器比较
+JsonValue benchTimeToTarget(const std::string& algorithm, const Target& target, int pop, const Options& opt) {
+    std::unique_ptr<ObjectiveFunction> objective = createObjective(target.function, target.dim);
+    std::unique_ptr<Optimizer> optimizer =
+        makeOptimizer(algorithm, *objective, target.function, target.dim, pop, opt.targetGenerations, opt);
+    optimizer->getTelemetry().setEnabled(true);
+
+    std::vector<double> times, evaluations;
+    for (int r = 0; r < opt.targetRuns; ++r) {
+        optimizer->run();
+        for (const auto& s : optimizer->getTelemetry().getStats()) {
+            if (s.best <= target.fitness) {
+                times.push_back(s.elapsed);
+                evaluations.push_back(static_cast<double>(s.evaluations));
+                break;
+            }
+        }
+    }
+    std::ostringstream name;
+    name << caseName(algorithm, target.function, target.dim, pop, opt) << "/target=" << target.fitness;
+    JsonValue result = JsonValue::object();
+    result.set("name", name.str());
+    result.set("algorithm", algorithm);
+    result.set("function", target.function);
+    result.set("dim", target.dim);
+    result.set("pop_size", pop);
+    result.set("target", target.fitness);
+    result.set("runs", opt.targetRuns);
+    result.set("successes", static_cast<int>(times.size()));
+    // 只统计成功的运行
+    result.set("seconds", summarize(times, true));
+    result.set("evaluations", summarize(evaluations, true));
+    return result;
+}
+
+// 取 section 中每项 metric 的中位数，按名称索引
+std::map<std::string, double> medians(const JsonValue& root, const char* section, const char* metric) {
+    std::map<std::string, double> out;
+    const JsonValue* list = root.get(section);
+    if (!list) return out;
+    for (const auto& item : list->items()) {
+        const JsonValue* name = item.get("name");
+        const JsonValue* m = item.get(metric);
+        const JsonValue* median = m ? m->get("median") : nullptr;
+        if (name && median && median->getType() == JsonValue::Number) out[name->asString()] = median->asNumber();
+    }
+    return out;
+}
+
+// 与基线比较单位耗时（越小越好），慢于 1 + tolerance 倍记为退化
+JsonValue compare(const JsonValue& current, const JsonValue& baseline, double tolerance, int& regressions) {
+    JsonValue list = JsonValue::array();
+    const char* sections[][2] = {{"objectives", "ns_per_eval"}, {"optimizers", "ns_per_gen"}};
+    std::cout << "\nComparison with baseline (" << sections[0][1] << ", " << sections[1][1] << " medians)\n";
+    for (const auto& sm : sections) {
+        std::map<std::string, double> before = medians(baseline, sm[0], sm[1]);
+        std::map<std::string, double> after = medians(current, sm[0], sm[1]);
+        for (const auto& kv : after) {
+            auto it = before.find(kv.first);
+            if (it == before.end() || it->second <= 0) continue;
+            double ratio = kv.second / it->second;
+            bool regression = ratio > 1.0 + tolerance;
+            if (regression) ++regressions;
+            JsonValue c = JsonValue::object();
+            c.set("name", kv.first);
+            c.set("metric", sm[1]);
+            c.set("baseline", it->second);
+            c.set("current", kv.second);
+            c.set("ratio", ratio);
+            c.set("regression", regression);
+            list.push(c);
+            std::printf("  %-48s %12.1f -> %12.1f  %+6.1f%%%s\n", kv.first.c_str(), it->second, kv.second,
+                        (ratio - 1.0) * 100, regression ? "  REGRESSION" : "");
+        }
+    }
+    return list;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    try {
+        opt = parseOptions(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        std::unique_ptr<ThreadPool> pool;
+        if (opt.threads > 0) {
+            pool.reset(new ThreadPool(opt.threads));
+            opt.pool = pool.get();
+        }
+        JsonValue root = JsonValue::object();
+        JsonValue host = JsonValue::object();
+        host.set("cpu", cpuModel());
+        host.set("hardware_threads", static_cast<int>(std::thread::hardware_concurrency()));
+        host.set("compiler", __VERSION__);
+        bool pinned = opt.cpu >= 0 && pinToCpu(opt.cpu);
+        if (opt.cpu >= 0 && !pinned) std::cerr << "Warning: could not pin to CPU " << opt.cpu << "\n";
+        host.set("pinned_cpu", pinned ? JsonValue(opt.cpu) : JsonValue());
+        root.set("host", host);
+        JsonValue settings = JsonValue::object();
+        settings.set("generations", opt.generations);
+        settings.set("repeat", opt.repeat);
+        settings.set("warmup", opt.warmup);
+        settings.set("target_runs", opt.targetRuns);
+        settings.set("target_generations", opt.targetGenerations);
+        settings.set("threads", opt.threads);
+        settings.set("scalar", sizeof(Scalar) == sizeof(float) ? "float" : "double");
+        root.set("settings", settings);
+
+        if (opt.objectives) {
+            JsonValue& list = root.set("objectives", JsonValue::array());
+            for (const auto& f : opt.functions) {
+                for (int dim : opt.dims) {
+                    const JsonValue& r = list.push(benchObjective(f, dim, opt));
+                    std::printf("%-48s %12.1f ns/eval\n", r.get("name")->asString().c_str(),
+                                r.get("ns_per_eval")->get("median")->asNumber());
+                    std::fflush(stdout);
+                }
+            }
+        }
+        if (opt.optimizers) {
+            JsonValue& list = root.set("optimizers", JsonValue::array());
+            for (const auto& f : opt.functions) {
+                for (int dim : opt.dims) {
+                    for (int pop : opt.pops) {
+                        for (const auto& a : opt.algorithms) {
+                            const JsonValue& r = list.push(benchOptimizer(a, f, dim, pop, opt));
+                            std::printf("%-48s %12.1f ns/gen %12.0f evals/s\n", r.get("name")->asString().c_str(),
+                                        r.get("ns_per_gen")->get("median")->asNumber(),
+                                        r.get("evals_per_sec")->get("median")->asNumber());
+                            std::fflush(stdout);
+                        }
+                    }
+                }
+            }
+        }
+        if (opt.timeToTarget) {
+            JsonValue& list = root.set("time_to_target", JsonValue::array());
+            for (const auto& t : opt.targets) {
+                for (const auto& a : opt.algorithms) {
+                    const JsonValue& r = list.push(benchTimeToTarget(a, t, opt.pops.front(), opt));
+                    std::printf("%-48s %3d/%-3d hit, median %.4f s, %.0f evals\n", r.get("name")->asString().c_str(),
+                                static_cast<int>(r.get("successes")->asNumber()), opt.targetRuns,
+                                r.get("seconds")->get("median")->asNumber(),
+                                r.get("evaluations")->get("median")->asNumber());
+                    std::fflush(stdout);
+                }
+            }
+        }
+
+        int regressions = 0;
+        if (!opt.baseline.empty()) {
+            std::ifstream in(opt.baseline);
+            if (!in) throw std::runtime_error("cannot open baseline " + opt.baseline);
+            std::stringstream text;
+            text << in.rdbuf();
+            JsonValue baseline = parseJson(text.str());
+            root.set("baseline", opt.baseline);
+            root.set("comparison", compare(root, baseline, opt.tolerance, regressions));
+        }
+
+        root.set("peak_memory_kb", static_cast<double>(peakMemoryKb()));
+
+        std::ofstream out(opt.output);
+        if (!out) throw std::runtime_error("cannot write " + opt.output);
+        root.write(out);
+        out << "\n";
+        std::cout << "Results written to " << opt.output << "\n";
+        if (regressions > 0) {
+            std::cout << regressions << " regression(s) beyond " << opt.tolerance * 100 << "%\n";
+            return 2;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+#include "fopt.h"
+#include "../Factory.h"
+#include "../ThreadPool.h"
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct fopt_objective {
+    std::unique_ptr<ObjectiveFunction> function;
+    int dim;
+};
+
+struct fopt_optimizer {
+    std::unique_ptr<Optimizer> optimizer;
+    std::unique_ptr<ThreadPool> pool;
+    int dim;
+    std::string stopReason;
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+// 把 C++ 异常转换为返回值，异常不能越过 C 接口
+template <typename R, typename F>
+R guard(R failure, F body) {
+    try {
+        lastError.clear();
+        return body();
+    } catch (const std::exception& e) {
+        lastError = e.what();
+    } catch (...) {
+        lastError = "unknown error";
+    }
+    return failure;
+}
+
+void require(bool condition, const char* message) {
+    if (!condition) throw std::invalid_argument(message);
+}
+
+// 回调计算的目标函数，批量评估直接把调用方的缓冲区交给回调，不做复制
+class CallbackObjective : public ObjectiveFunction {
+public:
+    CallbackObjective(int dim, fopt_eval_fn callback, void* user) : dim(dim), callback(callback), user(user) {}
+
+    virtual Scalar eval(const std::vector<Scalar>& x) const override {
+        Scalar y;
+        callback(x.data(), 1, dim, &y, user);
+        return y;
+    }
+    virtual void evalBatch(const Scalar* X, int n, int dim, Scalar* out) const override {
+        if (n > 0) callback(X, n, dim, out, user);
+    }
+    // 回调可能进入其他语言的运行时（如 Python 解释器），不能在 fork 出的子进程中调用
+    virtual bool forkSafe(bool) const override { return false; }
+    // 每次回调都要进出其他语言的运行时，一代的点一次交给回调
+    virtual bool prefersBatch() const override { return true; }
+
+private:
+    int dim;
+    fopt_eval_fn callback;
+    void* user;
+};
+
+} // namespace
+
+int fopt_api_version(void) {
+    return FOPT_API_VERSION;
+}
+
+int fopt_scalar_size(void) {
+    return static_cast<int>(sizeof(Scalar));
+}
+
+const char* fopt_last_error(void) {
+    return lastError.c_str();
+}
+
+fopt_objective* fopt_objective_create(const char* name, int dim) {
+    return guard<fopt_objective*>(nullptr, [&]() {
+        require(name != nullptr, "objective name is null");
+        require(dim > 0, "dimension must be positive");
+        return new fopt_objective{createObjective(name, dim), dim};
+    });
+}
+
+fopt_objective* fopt_objective_from_callback(int dim, fopt_eval_fn eval, void* user) {
+    return guard<fopt_objective*>(nullptr, [&]() {
+        require(eval != nullptr, "evaluation callback is null");
+        require(dim > 0, "dimension must be positive");
+        return new fopt_objective{std::unique_ptr<ObjectiveFunction>(new CallbackObjective(dim, eval, user)), dim};
+    });
+}
+
+int fopt_objective_eval(const fopt_objective* objective, const void* X, int n, int dim, void* out) {
+    return guard(-1, [&]() {
+        require(objective != nullptr, "objective is null");
+        require(dim == objective->dim, "dimension does not match the objective");
+        require(n >= 0 && (n == 0 || (X && out)), "invalid point buffer");
+        objective->function->evalBatch(static_cast<const Scalar*>(X), n, dim, static_cast<Scalar*>(out));
+        return 0;
+    });
+}
+
+void fopt_objective_destroy(fopt_objective* objective) {
+    delete objective;
+}
+
+fopt_optimizer* fopt_optimizer_create(const char* algorithm, const fopt_objective* objective, int dim,
+                                      double xmin, double xmax,
+                                      const char* const* keys, const double* values, int count) {
+    return guard<fopt_optimizer*>(nullptr, [&]() {
+        require(algorithm != nullptr, "algorithm name is null");
+        require(objective != nullptr, "objective is null");
+        require(dim == objective->dim, "dimension does not match the objective");
+        require(xmin < xmax, "x_min must be less than x_max");
+        require(count >= 0 && (count == 0 || (keys && values)), "invalid parameter arrays");
+        ParameterSet params;
+        for (int i = 0; i < count; ++i) {
+            require(keys[i] != nullptr, "parameter name is null");
+            params[keys[i]] = values[i];
+        }
+        std::unique_ptr<fopt_optimizer> handle(new fopt_optimizer);
+        handle->optimizer = createOptimizer(algorithm, *objective->function, dim, xmin, xmax, params);
+        handle->dim = dim;
+        return handle.release();
+    });
+}
+
+void fopt_optimizer_destroy(fopt_optimizer* optimizer) {
+    delete optimizer;
+}
+
+int fopt_optimizer_set_threads(fopt_optimizer* optimizer, int threads) {
+    return guard(-1, [&]() {
+        require(optimizer != nullptr, "optimizer is null");
+        require(threads >= 0, "thread count must not be negative");
+        optimizer->optimizer->setThreadPool(nullptr);
+        optimizer->pool.reset(threads == 1 ? nullptr : new ThreadPool(threads));
+        optimizer->optimizer->setThreadPool(optimizer->pool.get());
+        return 0;
+    });
+}
+
+int fopt_optimizer_enable_telemetry(fopt_optimizer* optimizer, int enabled) {
+    return guard(-1, [&]() {
+        require(optimizer != nullptr, "optimizer is null");
+        optimizer->optimizer->getTelemetry().setEnabled(enabled != 0);
+        return 0;
+    });
+}
+
+int fopt_optimizer_set_progress(fopt_optimizer* optimizer, fopt_progress_fn progress, int interval, void* user) {
+    return guard(-1, [&]() {
+        require(optimizer != nullptr, "optimizer is null");
+        require(interval > 0, "progress interval must be positive");
+        if (!progress) {
+            optimizer->optimizer->setProgressCallback(nullptr);
+            return 0;
+        }
+        optimizer->optimizer->setProgressCallback([progress, user](const Progress& p) {
+            progress(p.generation, p.evaluations, p.elapsed, p.best->fitness, user);
+        }, interval);
+        return 0;
+    });
+}
+
+int fopt_optimizer_run(fopt_optimizer* optimizer) {
+    return guard(-1, [&]() {
+        require(optimizer != nullptr, "optimizer is null");
+        optimizer->optimizer->run();
+        optimizer->stopReason = optimizer->optimizer->getStopReason();
+        return 0;
+    });
+}
+
+int fopt_optimizer_best(const fopt_optimizer* optimizer, void* position, void* fitness) {
+    return guard(-1, [&]() {
+        require(optimizer != nullptr, "optimizer is null");
+        const Individual& best = optimizer->optimizer->getBestIndividual();
+        if (position) std::copy(best.position.begin(), best.position.end(), static_cast<Scalar*>(position));
+        if (fitness) *static_cast<Scalar*>(fitness) = best.fitness;
+        return 0;
+    });
+}
+
+long long fopt_optimizer_evaluations(const fopt_optimizer* optimizer) {
+    return optimizer ? optimizer->optimizer->getEvaluationCount() : -1;
+}
+
+const char* fopt_optimizer_stop_reason(const fopt_optimizer* optimizer) {
+    return optimizer ? optimizer->stopReason.c_str() : "";
+}
+
+int fopt_optimizer_population(const fopt_optimizer* optimizer, void* X, void* fitness, int capacity) {
+    return guard(-1, [&]() {
+        require(optimizer != nullptr, "optimizer is null");
+        require(capacity >= 0 && (capacity == 0 || (X && fitness)), "invalid population buffer");
+        return optimizer->optimizer->copyPopulation(static_cast<Scalar*>(X), static_cast<Scalar*>(fitness), capacity);
+    });
+}
+
+int fopt_optimizer_trace(const fopt_optimizer* optimizer, double* out, int capacity) {
+    return guard(-1, [&]() {
+        require(optimizer != nullptr, "optimizer is null");
+        require(capacity >= 0 && (capacity == 0 || out), "invalid trace buffer");
+        const std::vector<GenerationStats>& stats = optimizer->optimizer->getTelemetry().getStats();
+        int rows = static_cast<int>(stats.size());
+        for (int g = 0; g < std::min(rows, capacity); ++g) {
+            const GenerationStats& s = stats[g];
+            double* row = out + static_cast<size_t>(g) * FOPT_TRACE_COLUMNS;
+            row[0] = s.generation;
+            row[1] = s.elapsed;
+            row[2] = static_cast<double>(s.evaluations);
+            row[3] = s.best;
+            row[4] = s.mean;
+            row[5] = s.diversity;
+            row[6] = s.selectionTime;
+            row[7] = s.variationTime;
+            row[8] = s.evaluationTime;
+        }
+        return rows;
+    });
+}
@@ -0,0 +1,68 @@
+#ifndef FOPT_H
+#define FOPT_H
+
+// 共享库 libfopt.so 的 C 接口，供 Python（见 fopt.py）等其他语言在进程内调用。
+// 只使用不透明句柄、基本类型与调用方提供的缓冲区，不暴露任何 C++ 类型，库内部的改动不影响二进制接口。
+// 坐标与适应度的类型由 fopt_scalar_size() 给出（SCALAR=float 编译时为 4，否则为 8），
+// 统计量与参数总是 double。点集按行连续存放，第 i 个点为 X[i*dim .. i*dim+dim)。
+// 出错时返回 -1 或 NULL（另有说明的除外），fopt_last_error() 给出本线程最近一次错误的信息
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FOPT_API_VERSION 1
+#define FOPT_EXPORT __attribute__((visibility("default")))
+
+typedef struct fopt_objective fopt_objective;
+typedef struct fopt_optimizer fopt_optimizer;
+
+// 批量评估的回调：计算 n 个点的函数值写入 out。X 与 out 直接指向优化器内部的缓冲区，只在调用期间有效
+typedef void (*fopt_eval_fn)(const void* X, int n, int dim, void* out, void* user);
+// 进度回调，每隔 interval 代调用一次；best 为当前最优值
+typedef void (*fopt_progress_fn)(int generation, long long evaluations, double elapsed, double best, void* user);
+
+FOPT_EXPORT int fopt_api_version(void);
+FOPT_EXPORT int fopt_scalar_size(void);
+FOPT_EXPORT const char* fopt_last_error(void);
+
+// 按名称创建测试函数，名称同实验配置文件（如 rastrigin、shifted_rotated_ackley）
+FOPT_EXPORT fopt_objective* fopt_objective_create(const char* name, int dim);
+// 由回调计算的目标函数，优化器每代把整批点交给 eval 一次（有线程池时每个分段一次，可能在多个线程上同时调用）
+FOPT_EXPORT fopt_objective* fopt_objective_from_callback(int dim, fopt_eval_fn eval, void* user);
+FOPT_EXPORT int fopt_objective_eval(const fopt_objective* objective, const void* X, int n, int dim, void* out);
+// 目标函数须在使用它的所有优化器之后销毁
+FOPT_EXPORT void fopt_objective_destroy(fopt_objective* objective);
+
+// 创建优化器，算法名称与参数同实验配置文件（SA、GA、PSO、DE、CMAES 等；pop_size、max_gen、max_evals 等），
+// keys[i] 的取值为 values[i]，未给出的参数取默认值
+FOPT_EXPORT fopt_optimizer* fopt_optimizer_create(const char* algorithm, const fopt_objective* objective, int dim,
+                                                  double xmin, double xmax,
+                                                  const char* const* keys, const double* values, int count);
+FOPT_EXPORT void fopt_optimizer_destroy(fopt_optimizer* optimizer);
+// 在 threads 个线程上运行（0 表示全部硬件线程，1 表示串行，默认串行）
+FOPT_EXPORT int fopt_optimizer_set_threads(fopt_optimizer* optimizer, int threads);
+// 打开后 fopt_optimizer_trace() 可以取得每代的统计量
+FOPT_EXPORT int fopt_optimizer_enable_telemetry(fopt_optimizer* optimizer, int enabled);
+// progress 为 NULL 时取消回调。在回调中可以调用 fopt_optimizer_population() 取得当前种群
+FOPT_EXPORT int fopt_optimizer_set_progress(fopt_optimizer* optimizer, fopt_progress_fn progress, int interval, void* user);
+FOPT_EXPORT int fopt_optimizer_run(fopt_optimizer* optimizer);
+
+// 最优解写入 position（dim 个坐标，可以为 NULL），把最优值写入 fitness
+FOPT_EXPORT int fopt_optimizer_best(const fopt_optimizer* optimizer, void* position, void* fitness);
+FOPT_EXPORT long long fopt_optimizer_evaluations(const fopt_optimizer* optimizer);
+// 上一次运行提前结束的原因，运行满 max_gen 时为空串
+FOPT_EXPORT const char* fopt_optimizer_stop_reason(const fopt_optimizer* optimizer);
+// 当前种群写入 X（capacity×dim）与 fitness（capacity），返回种群大小；capacity 为 0 时只返回大小
+FOPT_EXPORT int fopt_optimizer_population(const fopt_optimizer* optimizer, void* X, void* fitness, int capacity);
+
+// 收敛过程每代一行、FOPT_TRACE_COLUMNS 列，依次为代数、时间(s)、评估次数、最优值、平均值、多样性，
+// 以及选择、变异、评估三个阶段的耗时(s)。最多写入 capacity 行，返回总行数；capacity 为 0 时只返回行数
+#define FOPT_TRACE_COLUMNS 9
+FOPT_EXPORT int fopt_optimizer_trace(const fopt_optimizer* optimizer, double* out, int capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FOPT_H
@@ -0,0 +1,236 @@
+import ctypes
+import os
+import numpy as np
+
+# In-process bindings for libfopt.so (build with `make lib`, see capi/fopt.h for the C API).
+# Points, populations and traces are passed as NumPy arrays that the library reads and writes
+# directly: nothing is serialized, and objective callbacks get views of the optimizer's buffers.
+
+EVAL_FN = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.c_void_p, ctypes.c_void_p)
+PROGRESS_FN = ctypes.CFUNCTYPE(None, ctypes.c_int, ctypes.c_longlong, ctypes.c_double, ctypes.c_double, ctypes.c_void_p)
+
+TRACE_COLUMNS = ('generation', 'elapsed', 'evaluations', 'best', 'mean', 'diversity',
+                 'selection_time', 'variation_time', 'evaluation_time')
+
+_lib = None
+_dtype = None
+
+
+def load(path=None):
+    """Load the shared library: `path`, $FOPT_LIBRARY, or libfopt.so next to this file.
+
+    Use libfopt_float.so (`make lib SCALAR=float`) for single precision; arrays then use float32.
+    """
+    global _lib, _dtype
+    if _lib is not None:
+        return _lib
+    path = path or os.environ.get('FOPT_LIBRARY') or os.path.join(os.path.dirname(os.path.abspath(__file__)), 'libfopt.so')
+    lib = ctypes.CDLL(path)
+    p, i, d = ctypes.c_void_p, ctypes.c_int, ctypes.c_double
+    signatures = {
+        'fopt_api_version': (i, []),
+        'fopt_scalar_size': (i, []),
+        'fopt_last_error': (ctypes.c_char_p, []),
+        'fopt_objective_create': (p, [ctypes.c_char_p, i]),
+        'fopt_objective_from_callback': (p, [i, EVAL_FN, p]),
+        'fopt_objective_eval': (i, [p, p, i, i, p]),
+        'fopt_objective_destroy': (None, [p]),
+        'fopt_optimizer_create': (p, [ctypes.c_char_p, p, i, d, d, ctypes.POINTER(ctypes.c_char_p), ctypes.POINTER(d), i]),
+        'fopt_optimizer_destroy': (None, [p]),
+        'fopt_optimizer_set_threads': (i, [p, i]),
+        'fopt_optimizer_enable_telemetry': (i, [p, i]),
+        'fopt_optimizer_set_progress': (i, [p, PROGRESS_FN, i, p]),
+        'fopt_optimizer_run': (i, [p]),
+        'fopt_optimizer_best': (i, [p, p, p]),
+        'fopt_optimizer_evaluations': (ctypes.c_longlong, [p]),
+        'fopt_optimizer_stop_reason': (ctypes.c_char_p, [p]),
+        'fopt_optimizer_population': (i, [p, p, p, i]),
+        'fopt_optimizer_trace': (i, [p, p, i]),
+    }
+    for name, (restype, argtypes) in signatures.items():
+        function = getattr(lib, name)
+        function.restype = restype
+        function.argtypes = argtypes
+    if lib.fopt_api_version() != 1:
+        raise RuntimeError(f"{path}: unsupported API version {lib.fopt_api_version()}")
+    _dtype = np.dtype(np.float32 if lib.fopt_scalar_size() == 4 else np.float64)
+    _lib = lib
+    return lib
+
+
+def scalar_dtype():
+    """NumPy dtype of positions and fitness values in the loaded library."""
+    load()
+    return _dtype
+
+
+def _check(result):
+    if result is None or (isinstance(result, int) and result < 0):
+        raise RuntimeError(_lib.fopt_last_error().decode())
+    return result
+
+
+def _pointer(array):
+    return array.ctypes.data_as(ctypes.c_void_p)
+
+
+def _points(X, dim):
+    """X as a C-contiguous (n, dim) array of the scalar type, without copying when it already is one."""
+    X = np.ascontiguousarray(X, dtype=scalar_dtype())
+    if X.ndim == 1:
+        X = X.reshape(1, -1)
+    if X.ndim != 2 or X.shape[1] != dim:
+        raise ValueError(f"expected points with {dim} coordinates, got shape {X.shape}")
+    return X
+
+
+class Objective:
+    """Objective function evaluated by the library.
+
+    Objective('rastrigin', 10) uses a built-in test function; Objective.from_callable(f, dim)
+    wraps a Python function that maps an (n, dim) array of points to n values.
+    """
+
+    def __init__(self, name, dim):
+        load()
+        self.dim = dim
+        self._callback = None
+        self._error = None
+        self._handle = _check(_lib.fopt_objective_create(name.encode(), dim))
+
+    @classmethod
+    def from_callable(cls, function, dim):
+        """The optimizer hands each generation to `function` as one (n, dim) array.
+
+        The array is a read-only view of the optimizer's own buffer and is only valid during the call.
+        If `function` raises, the points of that batch get NaN and the exception is re-raised
+        when the run (or the evaluation) returns.
+        """
+        load()
+        self = cls.__new__(cls)
+        self.dim = dim
+        self._error = None
+        pointer = ctypes.POINTER(np.ctypeslib.as_ctypes_type(_dtype))
+
+        def evaluate(X, n, d, out, _):
+            result = np.ctypeslib.as_array(ctypes.cast(out, pointer), shape=(n,))
+            try:
+                points = np.ctypeslib.as_array(ctypes.cast(X, pointer), shape=(n, d))
+                points.flags.writeable = False
+                result[:] = function(points)
+            except BaseException as e:
+                result[:] = np.nan
+                if self._error is None:
+                    self._error = e
+
+        self._callback = EVAL_FN(evaluate)
+        self._handle = _check(_lib.fopt_objective_from_callback(dim, self._callback, None))
+        return self
+
+    def __call__(self, X):
+        """Values at the rows of X."""
+        X = _points(X, self.dim)
+        out = np.empty(len(X), dtype=_dtype)
+        _check(_lib.fopt_objective_eval(self._handle, _pointer(X), len(X), self.dim, _pointer(out)))
+        self._raise_pending()
+        return out
+
+    def _raise_pending(self):
+        if self._error is not None:
+            error, self._error = self._error, None
+            raise error
+
+    def __del__(self):
+        if getattr(self, '_handle', None) and _lib is not None:
+            _lib.fopt_objective_destroy(self._handle)
+            self._handle = None
+
+
+class Optimizer:
+    """Optimizer created by name with the parameters of the experiment files.
+
+    Optimizer('DE', Objective('rastrigin', 10), -5.12, 5.12, pop_size=50, max_gen=200)
+    """
+
+    def __init__(self, algorithm, objective, xmin, xmax, threads=1, telemetry=True, **params):
+        load()
+        self.objective = objective      # keep the objective alive as long as the optimizer
+        self.dim = objective.dim
+        self._progress = None
+        self._error = None
+        keys = (ctypes.c_char_p * len(params))(*(k.encode() for k in params))
+        values = (ctypes.c_double * len(params))(*(float(v) for v in params.values()))
+        self._handle = _check(_lib.fopt_optimizer_create(algorithm.encode(), objective._handle, self.dim,
+                                                         xmin, xmax, keys, values, len(params)))
+        _check(_lib.fopt_optimizer_set_threads(self._handle, threads))
+        _check(_lib.fopt_optimizer_enable_telemetry(self._handle, int(telemetry)))
+
+    def on_progress(self, function, interval=1):
+        """Call function(optimizer, generation, evaluations, elapsed, best) every `interval` generations;
+        optimizer.population() inside it gives that generation's population. None removes the callback.
+
+        If `function` raises, it is not called again during that run, and the exception is re-raised
+        when run() returns."""
+        if function is None:
+            self._progress = None
+            _check(_lib.fopt_optimizer_set_progress(self._handle, PROGRESS_FN(), interval, None))
+            return
+
+        def progress(generation, evaluations, elapsed, best, _):
+            # ctypes would print and drop the exception, so keep it for run()
+            if self._error is not None:
+                return
+            try:
+                function(self, generation, evaluations, elapsed, best)
+            except BaseException as e:
+                self._error = e
+
+        self._progress = PROGRESS_FN(progress)
+        _check(_lib.fopt_optimizer_set_progress(self._handle, self._progress, interval, None))
+
+    def run(self):
+        """Run once and return (best position, best fitness)."""
+        self._error = None
+        _check(_lib.fopt_optimizer_run(self._handle))
+        self.objective._raise_pending()
+        if self._error is not None:
+            error, self._error = self._error, None
+            raise error
+        return self.best()
+
+    def best(self):
+        position = np.empty(self.dim, dtype=_dtype)
+        fitness = np.empty(1, dtype=_dtype)
+        _check(_lib.fopt_optimizer_best(self._handle, _pointer(position), _pointer(fitness)))
+        return position, fitness[0]
+
+    @property
+    def evaluations(self):
+        return _lib.fopt_optimizer_evaluations(self._handle)
+
+    @property
+    def stop_reason(self):
+        return _lib.fopt_optimizer_stop_reason(self._handle).decode()
+
+    def population(self):
+        """Current population as (positions (n, dim), fitness (n,))."""
+        size = _check(_lib.fopt_optimizer_population(self._handle, None, None, 0))
+        X = np.empty((size, self.dim), dtype=_dtype)
+        fitness = np.empty(size, dtype=_dtype)
+        _check(_lib.fopt_optimizer_population(self._handle, _pointer(X), _pointer(fitness), size))
+        return X, fitness
+
+    def trace(self):
+        """Per-generation statistics of the last run as a dict of arrays (see TRACE_COLUMNS)."""
+        rows = _check(_lib.fopt_optimizer_trace(self._handle, None, 0))
+        data = np.empty((rows, len(TRACE_COLUMNS)))
+        _check(_lib.fopt_optimizer_trace(self._handle, _pointer(data), rows))
+        trace = {name: data[:, k] for k, name in enumerate(TRACE_COLUMNS)}
+        trace['generation'] = trace['generation'].astype(int)
+        trace['evaluations'] = trace['evaluations'].astype(np.int64)
+        return trace
+
+    def __del__(self):
+        if getattr(self, '_handle', None) and _lib is not None:
+            _lib.fopt_optimizer_destroy(self._handle)
+            self._handle = None
@@ -4,39 +4,58 @@ import numpy as np
 import pandas as pd
 import matplotlib.pyplot as plt
 from matplotlib.animation import FuncAnimation
+from trace_reader import Trace
 
 # Function to compute the Rastrigin function
 def rastrigin(x, y):
     A = 10
     return A * 2 + (x**2 - A * np.cos(2 * np.pi * x)) + (y**2 - A * np.cos(2 * np.pi * y))
 
-# Function to read all CSV files and find the best run for a specific data folder
+# Function to list the run files of a data folder (.trace from the program, .csv from older runs)
+def run_files(folder_path):
+    return glob.glob(os.path.join(folder_path, "*.trace")) or glob.glob(os.path.join(folder_path, "*.csv"))
+
+# Function to load a run as (generations, positions[gen, individual, dim], fitness[gen, individual])
+def load_run(run_file):
+    if run_file.endswith(".trace"):
+        trace = Trace(run_file)
+        return trace.generation, trace.positions.transpose(0, 2, 1), trace.fitness
+
+    data = pd.read_csv(run_file)
+    # Ensure 'Generation' and 'Fitness' columns are numeric
+    data['Generation'] = pd.to_numeric(data['Generation'], errors='coerce')
+    data['Fitness'] = pd.to_numeric(data['Fitness'], errors='coerce')
+    # Drop rows with NaN in 'Generation' or 'Fitness'
+    data = data.dropna(subset=['Generation', 'Fitness'])
+    data['Generation'] = data['Generation'].astype(int)
+
+    generations = np.sort(data['Generation'].unique())
+    x_columns = [c for c in data.columns if c.startswith('x')]
+    groups = [data[data['Generation'] == gen] for gen in generations]
+    positions = np.array([group[x_columns].values for group in groups], dtype=float)
+    fitness = np.array([group['Fitness'].values for group in groups], dtype=float)
+    return generations, positions, fitness
+
+# Function to read all run files and find the best run for a specific data folder
 def find_best_run(folder_path):
-    csv_files = glob.glob(os.path.join(folder_path, "*.csv"))
     best_run = None
     best_fitness = float('inf')
 
-    for csv_file in csv_files:
-        data = pd.read_csv(csv_file)
-        # Ensure the 'Fitness' column is numeric
-        data['Fitness'] = pd.to_numeric(data['Fitness'], errors='coerce')
-
-        # Drop rows with NaN Fitness values
-        data = data.dropna(subset=['Fitness'])
-
-        last_generation = data[data['Generation'] == data['Generation'].max()]
-        min_fitness = last_generation['Fitness'].min()
+    for run_file in run_files(folder_path):
+        _, _, fitness = load_run(run_file)
+        if len(fitness) == 0:
+            continue
+        min_fitness = np.nanmin(fitness[-1])
 
         if min_fitness < best_fitness:
             best_fitness = min_fitness
-            best_run = csv_file
+            best_run = run_file
 
     return best_run
 
 # Function to generate the animation for the optimization process
-def generate_animation(csv_file, output_path):
-    data = pd.read_csv(csv_file)
-    generations = data['Generation'].unique()
+def generate_animation(run_file, output_path):
+    generations, positions, _ = load_run(run_file)
 
     # Create Rastrigin function background
     x = np.linspace(-5.12, 5.12, 200)
@@ -52,13 +71,12 @@ def generate_animation(csv_file, output_path):
     ax.set_xlim(-5.12, 5.12)
     ax.set_ylim(-5.12, 5.12)
 
-    def update(gen):
-        population = data[data['Generation'] == gen]
-        scatter.set_offsets(population[['x1', 'x2']].values)
-        ax.set_title(f"Generation: {gen}")
+    def update(frame):
+        scatter.set_offsets(positions[frame][:, :2])
+        ax.set_title(f"Generation: {generations[frame]}")
         return scatter,
 
-    ani = FuncAnimation(fig, update, frames=generations, blit=True)
+    ani = FuncAnimation(fig, update, frames=len(generations), blit=True)
     ani.save(output_path, writer='pillow', fps=10)
     plt.close()
 
@@ -67,23 +85,15 @@ def plot_fitness_curves(folder_paths, output_path):
     plt.figure(figsize=(10, 6))
     for folder_path in folder_paths:
         algorithm_name = os.path.basename(folder_path).replace("_data", "")
-        csv_files = glob.glob(os.path.join(folder_path, "*.csv"))
         best_fitness_by_generation = []
 
-        for csv_file in csv_files:
-            data = pd.read_csv(csv_file)
-            # Ensure 'Generation' and 'Fitness' columns are numeric
-            data['Generation'] = pd.to_numeric(data['Generation'], errors='coerce')
-            data['Fitness'] = pd.to_numeric(data['Fitness'], errors='coerce')
-
-            # Drop rows with NaN in 'Generation' or 'Fitness'
-            data = data.dropna(subset=['Generation', 'Fitness'])
-            data['Generation'] = data['Generation'].astype(int)
-
-            max_generation = data['Generation'].max()
-            fitness_by_generation = [
-                data[data['Generation'] == gen]['Fitness'].min() for gen in range(max_generation + 1)
-            ]
+        for run_file in run_files(folder_path):
+            generations, _, fitness = load_run(run_file)
+            # Generations dropped by the trace writer are filled from the previous one
+            max_generation = generations.max()
+            fitness_by_generation = np.full(max_generation + 1, np.nan)
+            fitness_by_generation[generations] = np.nanmin(fitness, axis=1)
+            fitness_by_generation = pd.Series(fitness_by_generation).ffill().values
             best_fitness_by_generation.append(fitness_by_generation)
 
         # Calculate the average fitness for each generation across runs
@@ -0,0 +1,56 @@
+import os
+import sys
+import numpy as np
+
+# Binary population trace written by TraceWriter (see TraceWriter.h for the layout).
+# The writer stores little-endian values on every host, hence '<u4' and '<f8'.
+HEADER_DTYPE = np.dtype([('magic', 'S8'), ('version', '<u4'), ('dim', '<u4'), ('rows', '<u4'), ('reserved', '<u4')])
+
+
+class Trace:
+    """Memory-mapped view of a .trace file.
+
+    generation: (G,)            generation index of each block
+    positions:  (G, dim, rows)  columnar positions, positions[g, d] is coordinate d of every row
+    fitness:    (G, rows)
+    """
+
+    def __init__(self, path):
+        header = np.fromfile(path, dtype=HEADER_DTYPE, count=1)
+        if len(header) != 1 or header[0]['magic'] != b'OPTTRACE':
+            raise ValueError(f"{path} is not a population trace file")
+        self.dim = int(header[0]['dim'])
+        self.rows = int(header[0]['rows'])
+
+        block = 1 + (self.dim + 1) * self.rows
+        count = (os.path.getsize(path) - HEADER_DTYPE.itemsize) // (block * 8)
+        if count > 0:
+            data = np.memmap(path, dtype='<f8', mode='r', offset=HEADER_DTYPE.itemsize, shape=(count, block))
+        else:
+            data = np.empty((0, block))
+
+        self.generation = data[:, 0].astype(int)
+        self.positions = data[:, 1:1 + self.dim * self.rows].reshape(count, self.dim, self.rows)
+        self.fitness = data[:, 1 + self.dim * self.rows:]
+
+    def population(self, index):
+        """Positions of block `index` as a (rows, dim) array."""
+        return self.positions[index].T
+
+
+def to_csv(trace, out):
+    """Write a trace in the old population_run_*.csv layout."""
+    header = ["Generation", "Individual"] + [f"x{d + 1}" for d in range(trace.dim)] + ["Fitness"]
+    out.write(",".join(header) + "\n")
+    for g in range(len(trace.generation)):
+        pop = trace.population(g)
+        for i in range(trace.rows):
+            values = ",".join(f"{v:.6f}" for v in pop[i])
+            out.write(f"{trace.generation[g]},{i},{values},{trace.fitness[g, i]:.6f}\n")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        print(f"Usage: python {sys.argv[0]} <file.trace> > population.csv")
+        sys.exit(1)
+    to_csv(Trace(sys.argv[1]), sys.stdout)
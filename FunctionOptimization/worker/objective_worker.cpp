@@ -0,0 +1,68 @@
+// 外部目标函数的示例工作进程，协议见 ExternalObjective.h：从标准输入读请求，向标准输出写应答，读到 EOF 时退出。
+// 用法：objective_worker [rastrigin|echo] [delay_us]
+//   rastrigin  计算 Rastrigin 函数（默认）
+//   echo       返回每个点的第一个坐标，用于检查数据的传递
+//   delay_us   每个点额外等待的微秒数，模拟耗时的仿真
+#include "../RastriginFunction.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+bool readAll(int fd, void* data, size_t bytes) {
+    char* p = static_cast<char*>(data);
+    while (bytes > 0) {
+        ssize_t got = read(fd, p, bytes);
+        if (got <= 0) return false;
+        p += got;
+        bytes -= got;
+    }
+    return true;
+}
+
+bool writeAll(int fd, const void* data, size_t bytes) {
+    const char* p = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t written = write(fd, p, bytes);
+        if (written <= 0) return false;
+        p += written;
+        bytes -= written;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    bool echo = argc > 1 && std::strcmp(argv[1], "echo") == 0;
+    if (argc > 1 && !echo && std::strcmp(argv[1], "rastrigin") != 0) {
+        std::fprintf(stderr, "Usage: %s [rastrigin|echo] [delay_us]\n", argv[0]);
+        return 1;
+    }
+    int delay = argc > 2 ? std::atoi(argv[2]) : 0;
+
+    std::vector<double> X, f;
+    std::vector<Scalar> x;
+    uint32_t header[2];
+    while (readAll(STDIN_FILENO, header, sizeof(header))) {
+        uint32_t count = header[0], dim = header[1];
+        if (count == 0) break;
+        X.resize(static_cast<size_t>(count) * dim);
+        f.resize(count);
+        if (!readAll(STDIN_FILENO, X.data(), X.size() * sizeof(double))) return 1;
+        RastriginFunction rastrigin(dim);
+        for (uint32_t i = 0; i < count; ++i) {
+            x.assign(X.begin() + static_cast<size_t>(i) * dim, X.begin() + static_cast<size_t>(i + 1) * dim);
+            f[i] = echo ? X[static_cast<size_t>(i) * dim] : rastrigin.eval(x);
+            if (delay > 0) std::this_thread::sleep_for(std::chrono::microseconds(delay));
+        }
+        if (!writeAll(STDOUT_FILENO, f.data(), f.size() * sizeof(double))) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include "gasa.h"
+#include "../gasa_solver.h"
+#include "../tsp_instance.h"
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#ifndef ENABLE_DATA_COLLECTION
+#error "the C API needs the history recorded with ENABLE_DATA_COLLECTION"
+#endif
+
+struct tsp_solver {
+    // 求解器只保存实例的引用，实例由句柄持有
+    TSPInstance instance;
+    std::unique_ptr<GASATspSolver> solver;
+    bool solved = false;
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+// 把 C++ 异常转换为返回值，异常不能越过 C 接口
+template <typename R, typename F>
+R guard(R failure, F body) {
+    try {
+        lastError.clear();
+        return body();
+    } catch (const std::exception& e) {
+        lastError = e.what();
+    } catch (...) {
+        lastError = "unknown error";
+    }
+    return failure;
+}
+
+void require(bool condition, const char* message) {
+    if (!condition) throw std::invalid_argument(message);
+}
+
+void requireSolved(const tsp_solver* solver) {
+    require(solver != nullptr, "solver is null");
+    require(solver->solved, "solver has not been run");
+}
+
+} // namespace
+
+int tsp_api_version(void) {
+    return TSP_API_VERSION;
+}
+
+const char* tsp_last_error(void) {
+    return lastError.c_str();
+}
+
+tsp_solver* tsp_solver_create(const int* xy, int n, int pop_size, int generations,
+                              double cross_rate, double mutation_rate,
+                              double initial_temp, double cooling_rate) {
+    return guard<tsp_solver*>(nullptr, [&]() {
+        require(xy != nullptr && n >= 2, "an instance needs at least two cities");
+        require(pop_size > 0 && generations > 0, "population size and generations must be positive");
+        require(cooling_rate > 0 && cooling_rate < 1, "cooling rate must be in (0, 1)");
+        std::unique_ptr<tsp_solver> handle(new tsp_solver);
+        handle->instance.loadFromArray(xy, n);
+        handle->solver.reset(new GASATspSolver(handle->instance, pop_size, generations,
+                                               cross_rate, mutation_rate, initial_temp, cooling_rate));
+        return handle.release();
+    });
+}
+
+void tsp_solver_destroy(tsp_solver* solver) {
+    delete solver;
+}
+
+int tsp_solver_solve(tsp_solver* solver) {
+    return guard(-1, [&]() {
+        require(solver != nullptr, "solver is null");
+        solver->solver->solve();
+        solver->solved = true;
+        return 0;
+    });
+}
+
+int tsp_solver_cities(const tsp_solver* solver) {
+    return solver ? static_cast<int>(solver->instance.getCities().size()) : -1;
+}
+
+double tsp_solver_best_distance(const tsp_solver* solver) {
+    return guard(-1.0, [&]() {
+        requireSolved(solver);
+        return solver->solver->getBestDistance();
+    });
+}
+
+int tsp_solver_best_route(const tsp_solver* solver, int* route) {
+    return guard(-1, [&]() {
+        requireSolved(solver);
+        require(route != nullptr, "route buffer is null");
+        const std::vector<int>& best = solver->solver->getBestRoute();
+        std::copy(best.begin(), best.end(), route);
+        return 0;
+    });
+}
+
+int tsp_solver_history_length(const tsp_solver* solver) {
+    return guard(-1, [&]() {
+        require(solver != nullptr, "solver is null");
+        return static_cast<int>(solver->solver->getDistanceHistory().size());
+    });
+}
+
+int tsp_solver_distance_history(const tsp_solver* solver, double* distances, int capacity) {
+    return guard(-1, [&]() {
+        require(solver != nullptr, "solver is null");
+        require(capacity >= 0 && (capacity == 0 || distances), "invalid history buffer");
+        const std::vector<double>& history = solver->solver->getDistanceHistory();
+        int rows = static_cast<int>(history.size());
+        std::copy(history.begin(), history.begin() + std::min(rows, capacity), distances);
+        return rows;
+    });
+}
+
+int tsp_solver_route_history(const tsp_solver* solver, int* routes, int capacity) {
+    return guard(-1, [&]() {
+        require(solver != nullptr, "solver is null");
+        require(capacity >= 0 && (capacity == 0 || routes), "invalid history buffer");
+        const std::vector<std::vector<int>>& history = solver->solver->getRouteHistory();
+        int rows = static_cast<int>(history.size());
+        size_t n = solver->instance.getCities().size();
+        for (int g = 0; g < std::min(rows, capacity); g++) {
+            std::copy(history[g].begin(), history[g].end(), routes + g * n);
+        }
+        return rows;
+    });
+}
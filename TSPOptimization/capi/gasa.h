@@ -0,0 +1,44 @@
+#ifndef GASA_CAPI_H
+#define GASA_CAPI_H
+
+// 共享库 libgasa.so 的 C 接口，供 Python（见 gasa.py）等其他语言在进程内调用 GASA 求解器。
+// 城市坐标为 n 个 (x, y) 整数对依次存放的数组，路径为城市下标的数组，结果写入调用方提供的缓冲区。
+// 库按 collect_data 的方式编译，总是记录每代的最短距离与最优路径。
+// 出错时返回 -1 或 NULL，tsp_last_error() 给出本线程最近一次错误的信息
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TSP_API_VERSION 1
+#define TSP_EXPORT __attribute__((visibility("default")))
+
+typedef struct tsp_solver tsp_solver;
+
+TSP_EXPORT int tsp_api_version(void);
+TSP_EXPORT const char* tsp_last_error(void);
+
+// 参数与 main 的命令行参数相同；坐标在创建时读入，之后 xy 可以释放
+TSP_EXPORT tsp_solver* tsp_solver_create(const int* xy, int n, int pop_size, int generations,
+                                         double cross_rate, double mutation_rate,
+                                         double initial_temp, double cooling_rate);
+TSP_EXPORT void tsp_solver_destroy(tsp_solver* solver);
+// 每次调用都从新的随机种群开始求解
+TSP_EXPORT int tsp_solver_solve(tsp_solver* solver);
+
+TSP_EXPORT int tsp_solver_cities(const tsp_solver* solver);
+TSP_EXPORT double tsp_solver_best_distance(const tsp_solver* solver);
+// 最优路径写入 route（n 个城市下标）
+TSP_EXPORT int tsp_solver_best_route(const tsp_solver* solver, int* route);
+// 上一次求解记录的代数
+TSP_EXPORT int tsp_solver_history_length(const tsp_solver* solver);
+// 每代的最短距离写入 distances，最多 capacity 代，返回总代数
+TSP_EXPORT int tsp_solver_distance_history(const tsp_solver* solver, double* distances, int capacity);
+// 每代的最优路径按行写入 routes（capacity×n），返回总代数
+TSP_EXPORT int tsp_solver_route_history(const tsp_solver* solver, int* routes, int capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GASA_CAPI_H
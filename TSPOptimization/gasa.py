@@ -0,0 +1,106 @@
+import ctypes
+import os
+import numpy as np
+
+# In-process bindings for libgasa.so (build with `make lib`, see capi/gasa.h for the C API).
+# Coordinates are read from the caller's NumPy array and the results are written straight
+# into NumPy arrays, without files or text serialization in between.
+
+_lib = None
+
+
+def load(path=None):
+    """Load the shared library: `path`, $GASA_LIBRARY, or libgasa.so next to this file."""
+    global _lib
+    if _lib is not None:
+        return _lib
+    path = path or os.environ.get('GASA_LIBRARY') or os.path.join(os.path.dirname(os.path.abspath(__file__)), 'libgasa.so')
+    lib = ctypes.CDLL(path)
+    p, i, d = ctypes.c_void_p, ctypes.c_int, ctypes.c_double
+    signatures = {
+        'tsp_api_version': (i, []),
+        'tsp_last_error': (ctypes.c_char_p, []),
+        'tsp_solver_create': (p, [p, i, i, i, d, d, d, d]),
+        'tsp_solver_destroy': (None, [p]),
+        'tsp_solver_solve': (i, [p]),
+        'tsp_solver_cities': (i, [p]),
+        'tsp_solver_best_distance': (d, [p]),
+        'tsp_solver_best_route': (i, [p, p]),
+        'tsp_solver_history_length': (i, [p]),
+        'tsp_solver_distance_history': (i, [p, p, i]),
+        'tsp_solver_route_history': (i, [p, p, i]),
+    }
+    for name, (restype, argtypes) in signatures.items():
+        function = getattr(lib, name)
+        function.restype = restype
+        function.argtypes = argtypes
+    if lib.tsp_api_version() != 1:
+        raise RuntimeError(f"{path}: unsupported API version {lib.tsp_api_version()}")
+    _lib = lib
+    return lib
+
+
+def _check(result):
+    if result is None or result < 0:
+        raise RuntimeError(_lib.tsp_last_error().decode())
+    return result
+
+
+def _pointer(array):
+    return array.ctypes.data_as(ctypes.c_void_p)
+
+
+def load_instance(path):
+    """City coordinates of an instance file (e.g. BEN30-XY.txt) as an (n, 2) int32 array."""
+    with open(path) as f:
+        tokens = f.read().split()
+    # like TSPInstance::loadFromStream, read only the count and n coordinate pairs (the files end with ^Z)
+    n = int(tokens[0])
+    return np.array(tokens[1:1 + 2 * n], dtype=np.int32).reshape(n, 2)
+
+
+class Result:
+    """best_distance, best_route (n,), distance_history (generations,) and route_history (generations, n)."""
+
+    def __init__(self, best_distance, best_route, distance_history, route_history):
+        self.best_distance = best_distance
+        self.best_route = best_route
+        self.distance_history = distance_history
+        self.route_history = route_history
+
+
+class Solver:
+    """GASA solver for one instance, with the same parameters as ./main."""
+
+    def __init__(self, cities, pop_size=200, generations=500, cross_rate=0.9, mutation_rate=0.1,
+                 initial_temp=1000, cooling_rate=0.99):
+        load()
+        cities = np.ascontiguousarray(cities, dtype=np.int32)
+        if cities.ndim != 2 or cities.shape[1] != 2:
+            raise ValueError(f"expected an (n, 2) array of coordinates, got shape {cities.shape}")
+        self.cities = cities
+        self._handle = _check(_lib.tsp_solver_create(_pointer(cities), len(cities), pop_size, generations,
+                                                     cross_rate, mutation_rate, initial_temp, cooling_rate))
+
+    def solve(self):
+        """Run once from a new random population and return a Result."""
+        _check(_lib.tsp_solver_solve(self._handle))
+        n = len(self.cities)
+        route = np.empty(n, dtype=np.int32)
+        _check(_lib.tsp_solver_best_route(self._handle, _pointer(route)))
+        generations = _check(_lib.tsp_solver_history_length(self._handle))
+        distances = np.empty(generations)
+        _check(_lib.tsp_solver_distance_history(self._handle, _pointer(distances), generations))
+        routes = np.empty((generations, n), dtype=np.int32)
+        _check(_lib.tsp_solver_route_history(self._handle, _pointer(routes), generations))
+        return Result(_lib.tsp_solver_best_distance(self._handle), route, distances, routes)
+
+    def __del__(self):
+        if getattr(self, '_handle', None) and _lib is not None:
+            _lib.tsp_solver_destroy(self._handle)
+            self._handle = None
+
+
+def solve(cities, **params):
+    """Solve once with the parameters of Solver and return a Result."""
+    return Solver(cities, **params).solve()
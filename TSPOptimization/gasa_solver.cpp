@@ -21,11 +21,17 @@ GASATspSolver::GASATspSolver(const TSPInstance &instance,
   initialTemperature(initial_temp),
   coolingRate(cooling_rate) {
   best_distance = std::numeric_limits<double>::infinity();
+  // 原先每个子代从 initialTemperature 降到 1 的步数
+  fullMoves = initialTemperature > 1 ? (int)std::ceil(std::log(initialTemperature) / -std::log(coolingRate)) : 0;
+  meanUphill = 1.0;
+  annealingMoves = 0;
 }
 
 void GASATspSolver::solve() {
     initializePopulation();
+    calibrateTemperature();
     best_distance = std::numeric_limits<double>::infinity();
+    annealingMoves = 0;
 #ifdef ENABLE_DATA_COLLECTION
     distance_history.clear();
     route_history.clear();
@@ -45,6 +51,10 @@ const std::vector<int>& GASATspSolver::getBestRoute() const {
     return best_route;
 }
 
+long long GASATspSolver::getAnnealingMoves() const {
+    return annealingMoves;
+}
+
 #ifdef ENABLE_DATA_COLLECTION
 const std::vector<double>& GASATspSolver::getDistanceHistory() const {
     return distance_history;
@@ -129,39 +139,92 @@ void GASATspSolver::mutate(std::vector<int>& individual) {
     std::swap(individual[a], individual[b]);
 }
 
-void GASATspSolver::simulatedAnnealing(std::vector<int>& route) {
-    double temperature = initialTemperature;
+void GASATspSolver::randomSegment(int n, int& a, int& b) {
+    // a != b，不产生原地不动的移动，否则它们总被接受，连续拒绝的计数无法累积
+    a = std::uniform_int_distribution<int>(0, n-1)(rng);
+    b = std::uniform_int_distribution<int>(0, n-2)(rng);
+    if (b >= a) b++;
+    if (a > b) std::swap(a, b);
+}
+
+double GASATspSolver::reverseDelta(const std::vector<int>& route, int a, int b) const {
     int n = (int)route.size();
-    std::vector<int> current_route = route;
-    double current_distance = inst.totalDistance(current_route);
+    if (a == b || (a == 0 && b == n - 1)) return 0; // 反转整条路径不改变长度
+    // p-route[a] ... route[b]-q 变为 p-route[b] ... route[a]-q
+    int p = route[(a + n - 1) % n];
+    int q = route[(b + 1) % n];
+    return inst.distance(p, route[b]) + inst.distance(route[a], q)
+         - inst.distance(p, route[a]) - inst.distance(route[b], q);
+}
 
-    std::uniform_int_distribution<int> dist_idx(0, n-1);
-    std::uniform_real_distribution<double> dist_real(0.0, 1.0);
+void GASATspSolver::calibrateTemperature() {
+    std::vector<int> route = population[0];
+    int n = (int)route.size();
+    double sum = 0;
+    int count = 0;
+    for (int i = 0; i < 10 * n; i++) {
+        int a, b;
+        randomSegment(n, a, b);
+        double delta = reverseDelta(route, a, b);
+        if (delta > 0) {
+            sum += delta;
+            count++;
+        }
+    }
+    meanUphill = count > 0 ? sum / count : 1.0;
+}
 
-    while (temperature > 1) {
-        int a = dist_idx(rng);
-        int b = dist_idx(rng);
-        std::swap(current_route[a], current_route[b]);
+double GASATspSolver::anneal(std::vector<int>& route, double length, int moves, double startAccept) {
+    int n = (int)route.size();
+    if (moves <= 0 || n < 4) return length; // 三个城市以内任何 2-opt 都不改变长度
 
-        double new_distance = inst.totalDistance(current_route);
-        double delta = new_distance - current_distance;
+    // 平均上坡步长 u 在温度 T 下被接受的概率为 exp(-u / T)
+    double startTemp = std::min(initialTemperature, -meanUphill / std::log(startAccept));
+    double endTemp = std::min(startTemp, -meanUphill / std::log(END_ACCEPT));
+    double cooling = std::pow(endTemp / startTemp, 1.0 / moves);
+    double temperature = startTemp;
 
+    std::uniform_real_distribution<double> dist_real(0.0, 1.0);
+    double uphillSum = 0;
+    int uphillCount = 0;
+    int rejections = 0;
+    for (int m = 0; m < moves; m++) {
+        int a, b;
+        randomSegment(n, a, b);
+        double delta = reverseDelta(route, a, b);
+        annealingMoves++;
+        if (delta > 0) {
+            uphillSum += delta;
+            uphillCount++;
+        }
         if (delta < 0 || exp(-delta / temperature) > dist_real(rng)) {
-            current_distance = new_distance;
-        } else {
-            // 撤销交换
-            std::swap(current_route[a], current_route[b]);
+            std::reverse(route.begin() + a, route.begin() + b + 1);
+            length += delta;
+            rejections = 0;
+        } else if (++rejections >= MAX_REJECTIONS * n) {
+            break;
         }
-
-        temperature *= coolingRate;
+        temperature *= cooling;
     }
+    if (uphillCount > 0) meanUphill = 0.9 * meanUphill + 0.1 * uphillSum / uphillCount;
+    return length;
+}
 
-    route = current_route;
+void GASATspSolver::simulatedAnnealing(std::vector<int>& route) {
+    // 与本代已有的个体相同，再退火只是重复已经做过的工作
+    if (seen.count(route)) return;
+    int shortMoves = std::min(fullMoves, std::max(1, fullMoves / SHORT_DIVISOR));
+    double length = anneal(route, inst.totalDistance(route), shortMoves, SHORT_ACCEPT);
+    if (length <= best_distance * (1 + ELITE_MARGIN)) {
+        anneal(route, length, fullMoves - shortMoves, LONG_ACCEPT);
+    }
+    seen.insert(route);
 }
 
 void GASATspSolver::nextGeneration() {
     std::vector<std::vector<int>> new_population;
     std::uniform_real_distribution<double> dist_real(0.0, 1.0);
+    seen.clear();
     for (int i = 0; i < popSize; i++) {
         std::vector<int> parent1 = selection();
         std::vector<int> parent2 = selection();
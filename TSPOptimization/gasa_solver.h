@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <random>
+#include <set>
 #include <string>
 #include "tsp_instance.h"
 
@@ -20,6 +21,8 @@ public:
     void solve();
     double getBestDistance() const;
     const std::vector<int>& getBestRoute() const;
+    // 上一次求解中模拟退火的总步数
+    long long getAnnealingMoves() const;
 #ifdef ENABLE_DATA_COLLECTION
     const std::vector<double>& getDistanceHistory() const;
     const std::vector<std::vector<int>>& getRouteHistory() const;
@@ -40,6 +43,24 @@ private:
     std::vector<std::vector<int>> population;
     std::vector<double> fitness;
 
+    // 自适应的模拟退火：每个子代先做一段短的退火（fullMoves / SHORT_DIVISOR 步），
+    // 只有结果在当前最优的 ELITE_MARGIN 之内的子代才继续退火，合计不超过 fullMoves 步；
+    // fullMoves 为原先从 initialTemperature 按 coolingRate 降到 1 的步数。
+    // 邻域为 2-opt（反转一段路径），长度变化只看两端的四条边。温度按观察到的上坡步长（长度增量）的均值标定：
+    // 始温使平均上坡被接受的概率为 SHORT_ACCEPT 或 LONG_ACCEPT，终温时为 END_ACCEPT，都不超过 initialTemperature。
+    // 连续 MAX_REJECTIONS × 城市数 步都被拒绝时提前结束，与本代已有个体完全相同的子代不再退火
+    static const int SHORT_DIVISOR = 8;
+    static constexpr double ELITE_MARGIN = 0.25;
+    static constexpr double SHORT_ACCEPT = 0.01;
+    static constexpr double LONG_ACCEPT = 0.2;
+    static constexpr double END_ACCEPT = 0.0001;
+    static const int MAX_REJECTIONS = 4;
+
+    int fullMoves;
+    double meanUphill;             // 上坡步长的指数平均
+    long long annealingMoves;
+    std::set<std::vector<int>> seen;   // 本代已经产生的个体
+
 #ifdef ENABLE_DATA_COLLECTION
     std::vector<double> distance_history;
     std::vector<std::vector<int>> route_history;
@@ -56,6 +77,14 @@ private:
     std::vector<int> crossover(const std::vector<int>& parent1, const std::vector<int>& parent2);
     void mutate(std::vector<int>& individual);
     void simulatedAnnealing(std::vector<int>& route);
+    // 从温度 startAccept 对应的温度开始退火 moves 步，返回结束时的路径长度
+    double anneal(std::vector<int>& route, double length, int moves, double startAccept);
+    // 随机选取 0 <= a < b < n
+    void randomSegment(int n, int& a, int& b);
+    // 反转 route 中位置 a..b（a <= b）的一段引起的路径长度变化
+    double reverseDelta(const std::vector<int>& route, int a, int b) const;
+    // 在随机路径上试探若干次 2-opt，得到上坡步长的初始估计
+    void calibrateTemperature();
     // 根据算子构造下一代种群
     void nextGeneration();
 };
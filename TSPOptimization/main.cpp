@@ -25,6 +25,11 @@ int main(int argc, char* argv[]) {
     double mutation_rate = stod(argv[4]);
     double initial_temp = stod(argv[5]);
     double cooling_rate = stod(argv[6]);
+    // 降温速率不在 (0, 1) 内时降温步数无意义（等于 1 时除以零）
+    if (!(cooling_rate > 0 && cooling_rate < 1)) {
+        cerr << "Error: cooling_rate must be in (0, 1)\n";
+        return 1;
+    }
 
     string folder_name = "results_" + to_string(pop_size) + "_" + to_string(generations) + "_" + to_string(cross_rate) + "_" + to_string(mutation_rate) + "_" + to_string(initial_temp) + "_" + to_string(cooling_rate);
     fs::create_directory(folder_name);
@@ -41,6 +46,8 @@ int main(int argc, char* argv[]) {
     vector<double> times;
     times.reserve(runs);
 
+    long long annealing_moves = 0;
+
 #ifdef ENABLE_DATA_COLLECTION
     // 创建文件夹存储每次运行的种群数据
     fs::create_directory(folder_name + "/data");
@@ -60,6 +67,8 @@ int main(int argc, char* argv[]) {
         double elapsed_time = diff.count();
         times.push_back(elapsed_time);
 
+        annealing_moves += solver.getAnnealingMoves();
+
         double best_dist = solver.getBestDistance();
         results.push_back(best_dist);
         vector<int> best_route = solver.getBestRoute();
@@ -136,6 +145,7 @@ int main(int argc, char* argv[]) {
     stats_file << "Worst Time: " << worst_time << "\n";
     stats_file << "Average Time: " << avg_time << "\n";
     stats_file << "Time Variance: " << time_variance << "\n";
+    stats_file << "Average SA Moves per Generation: " << (double)annealing_moves / runs / generations << "\n";
     stats_file.close();
 
     return 0;
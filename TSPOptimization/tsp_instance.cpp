@@ -11,6 +11,14 @@ void TSPInstance::loadFromStream(std::istream &in) {
     }
 }
 
+void TSPInstance::loadFromArray(const int* xy, int n) {
+    cities.resize(n);
+    for (int i = 0; i < n; i++) {
+        cities[i].x = xy[2 * i];
+        cities[i].y = xy[2 * i + 1];
+    }
+}
+
 double TSPInstance::distance(int a, int b) const {
     int dx = cities[a].x - cities[b].x;
     int dy = cities[a].y - cities[b].y;
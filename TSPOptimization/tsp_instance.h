@@ -12,6 +12,8 @@ struct City {
 class TSPInstance {
 public:
     void loadFromStream(std::istream &in);
+    // 从 n 个 (x, y) 坐标对依次存放的数组读取
+    void loadFromArray(const int* xy, int n);
     double distance(int a, int b) const;
     double totalDistance(const std::vector<int>& route) const;
 